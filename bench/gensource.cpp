@@ -0,0 +1,59 @@
+/**
+ * @file gensource.cpp
+ * @author DrkWithT
+ * @brief Implements the generated benchmark program.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "gensource.hpp"
+
+namespace fung::bench
+{
+    /// @note Identifiers may not contain digits, so names are told apart by a base-26 letter suffix instead.
+    static std::string makeSuffix(size_t number)
+    {
+        std::string suffix {};
+
+        do
+        {
+            suffix.insert(suffix.begin(), static_cast<char>('a' + number % 26));
+            number /= 26;
+        } while (number > 0);
+
+        return suffix;
+    }
+
+    std::string generateSource(size_t function_count)
+    {
+        std::string source {"# generated benchmark program #\n\nuse stdio\nuse stringify\n\n"};
+
+        for (size_t function_i = 0; function_i < function_count; function_i++)
+        {
+            std::string id = std::to_string(function_i);
+            std::string suffix = makeSuffix(function_i);
+
+            source.append("# record type and helper number " + id + " keep a running total over a short list of values #\n");
+            source.append("object Record" + suffix + "\n    field label\n    field amount\n    field nextRecord\nend\n\n");
+            source.append("fun computeValue" + suffix + "(val countLimit, ref itemValues)\n");
+            source.append("    mut runningTotal = 0\n    mut indexCounter = 0\n");
+            source.append("    let labelText = \"helper number " + id + " with a somewhat longer string literal inside\"\n");
+            source.append("    let scratch = [1, 2, 3, 4.5, " + id + ", \"text\", $T, nil]\n");
+            source.append("    mut record = Record" + suffix + " {labelText, 0, nil}\n\n");
+            source.append("    while indexCounter < countLimit\n");
+            source.append("        runningTotal = runningTotal + indexCounter * 3 - indexCounter / 2\n");
+            source.append("        indexCounter = indexCounter + 1\n    end\n\n");
+            source.append("    each item in itemValues\n");
+            source.append("        if item > runningTotal\n            runningTotal = item\n");
+            source.append("        end\n        else\n            runningTotal = runningTotal + 1.5\n        end\n    end\n\n");
+            source.append("    record[\"amount\"] = runningTotal\n");
+            source.append("    ret record[\"amount\"] + scratch[0]\nend\n\n");
+        }
+
+        source.append("print(toString(computeValuea(10, [5, 10, 15])))\n");
+
+        return source;
+    }
+}
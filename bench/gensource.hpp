@@ -0,0 +1,16 @@
+#ifndef GENSOURCE_HPP
+#define GENSOURCE_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace fung::bench
+{
+    /**
+     * @brief Generates a valid Fung program of `function_count` functions, each with a comment, an object type, loops, branches, list and string literals and calls, for the lexer and parser benchmarks.
+     * @note The output depends only on `function_count`, so runs stay comparable across builds.
+     */
+    std::string generateSource(size_t function_count);
+}
+
+#endif
@@ -0,0 +1,118 @@
+/**
+ * @file lexbench.cpp
+ * @author DrkWithT
+ * @brief Times the lexer on a large generated program at each scan kernel level, checking that all levels give the same tokens.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "frontend/lexer.hpp"
+#include "gensource.hpp"
+
+using namespace fung::frontend;
+
+/// @note Usage: `lexbench [function count]`, default 20000, i.e about 17 MiB of source.
+static constexpr size_t default_function_count = 20000;
+
+/// @note Each level is timed this many times and the fastest run is reported, to skip warmup and noise.
+static constexpr int timed_runs = 5;
+
+static const char* getLevelName(ScanKernelLevel level)
+{
+    switch (level)
+    {
+    case scan_level_scalar:
+        return "scalar";
+    case scan_level_sse2:
+        return "sse2";
+    case scan_level_avx2:
+    default:
+        return "avx2";
+    }
+}
+
+/// @note Keeps trivia tokens too, since whitespace and comments are what the kernels scan.
+static std::vector<Token> lexAll(const std::string& source, ScanKernelLevel level)
+{
+    Lexer lexer {source.data(), source.size(), level};
+    std::vector<Token> tokens {};
+    Token token {};
+
+    tokens.reserve(source.size() / 4);
+
+    do
+    {
+        token = lexer.lexNext();
+        tokens.push_back(token);
+    } while (token.type != token_eof);
+
+    return tokens;
+}
+
+static bool sameTokens(const std::vector<Token>& lhs, const std::vector<Token>& rhs)
+{
+    if (lhs.size() != rhs.size())
+    {
+        return false;
+    }
+
+    for (size_t token_i = 0; token_i < lhs.size(); token_i++)
+    {
+        if (lhs[token_i].begin != rhs[token_i].begin || lhs[token_i].length != rhs[token_i].length || lhs[token_i].type != rhs[token_i].type || lhs[token_i].symbol != rhs[token_i].symbol)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t function_count = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : default_function_count;
+    std::string source = fung::bench::generateSource(function_count);
+    std::vector<Token> scalar_tokens = lexAll(source, scan_level_scalar);
+    bool all_same = true;
+
+    std::cout << "source: " << source.size() << " bytes, " << scalar_tokens.size() << " tokens, detected level: " << getLevelName(detectScanKernelLevel()) << '\n';
+
+    for (ScanKernelLevel level : {scan_level_scalar, scan_level_sse2, scan_level_avx2})
+    {
+        /// @note Levels above what the CPU supports are downgraded by getScanKernels().
+        ScanKernelLevel used_level = getScanKernels(level).level;
+        double best_ms = 0.0;
+        std::vector<Token> tokens {};
+
+        for (int run = 0; run < timed_runs; run++)
+        {
+            auto start = std::chrono::steady_clock::now();
+
+            tokens = lexAll(source, level);
+
+            double run_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            best_ms = (run == 0 || run_ms < best_ms) ? run_ms : best_ms;
+        }
+
+        bool same = sameTokens(tokens, scalar_tokens);
+
+        all_same = all_same && same;
+
+        std::cout << getLevelName(level) << " (ran as " << getLevelName(used_level) << "): " << best_ms << " ms, " << (static_cast<double>(source.size()) / (1 << 20)) / (best_ms / 1000.0) << " MiB/s, tokens " << (same ? "match" : "DIFFER") << '\n';
+    }
+
+    if (!all_same)
+    {
+        std::cerr << "lexbench: kernel levels gave different token streams\n";
+        return 1;
+    }
+
+    return 0;
+}
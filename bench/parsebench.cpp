@@ -0,0 +1,97 @@
+/**
+ * @file parsebench.cpp
+ * @author DrkWithT
+ * @brief Parses a large generated program and reports the heap allocations, bytes and time it took.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include "frontend/parser.hpp"
+#include "gensource.hpp"
+
+/// @note Usage: `parsebench [function count]`, default 2000, i.e about 1.7 MiB of source.
+static constexpr size_t default_function_count = 2000;
+
+/// @note Counted by the replaced global operator new below, but only while counting_on is set, so generating the source is left out.
+static size_t allocation_count = 0;
+static size_t allocation_bytes = 0;
+static bool counting_on = false;
+
+void* operator new(std::size_t size)
+{
+    if (counting_on)
+    {
+        allocation_count++;
+        allocation_bytes += size;
+    }
+
+    if (void* block = std::malloc(size == 0 ? 1 : size); block != nullptr)
+    {
+        return block;
+    }
+
+    throw std::bad_alloc {};
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* block) noexcept
+{
+    std::free(block);
+}
+
+void operator delete[](void* block) noexcept
+{
+    std::free(block);
+}
+
+void operator delete(void* block, std::size_t) noexcept
+{
+    std::free(block);
+}
+
+void operator delete[](void* block, std::size_t) noexcept
+{
+    std::free(block);
+}
+
+int main(int argc, char* argv[])
+{
+    size_t function_count = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : default_function_count;
+    std::string source = fung::bench::generateSource(function_count);
+    double parse_ms = 0.0;
+    fung::frontend::ParserDumpState parse_state {};
+
+    {
+        counting_on = true;
+
+        auto start = std::chrono::steady_clock::now();
+        fung::frontend::ProgramUnit unit {"bench"};
+        fung::frontend::Parser parser {source};
+
+        parse_state = parser.parseFile(unit);
+        parse_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        counting_on = false;
+    }
+
+    std::cout << "source: " << source.size() << " bytes, " << function_count << " functions\n"
+              << "parse: " << parse_ms << " ms, " << allocation_count << " allocations, " << allocation_bytes << " bytes\n";
+
+    if (parse_state.status != fung::frontend::fung_parse_ok)
+    {
+        std::cerr << "parsebench: generated program failed to parse: " << parse_state.message << '\n';
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,235 @@
+/**
+ * @file valuebench.cpp
+ * @author DrkWithT
+ * @brief Times scalar arithmetic and comparison on the NaN-boxed Value against a std::variant baseline, counting any heap allocations.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <variant>
+#include "backend/value.hpp"
+
+using fung::backend::HeapObject;
+using fung::backend::Value;
+
+/// @note Usage: `valuebench [iterations per op]`, default 1e8.
+static constexpr size_t default_iterations = 100000000;
+
+/// @note Counted by the replaced global operator new below. Scalar ops on either representation should never reach it.
+static size_t allocation_count = 0;
+
+void* operator new(std::size_t size)
+{
+    allocation_count++;
+
+    if (void* block = std::malloc(size == 0 ? 1 : size); block != nullptr)
+    {
+        return block;
+    }
+
+    throw std::bad_alloc {};
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* block) noexcept
+{
+    std::free(block);
+}
+
+void operator delete[](void* block) noexcept
+{
+    std::free(block);
+}
+
+void operator delete(void* block, std::size_t) noexcept
+{
+    std::free(block);
+}
+
+void operator delete[](void* block, std::size_t) noexcept
+{
+    std::free(block);
+}
+
+/// @note The std::variant Value the NaN-boxed one replaced, kept to its scalar API, as the baseline.
+class VariantValue
+{
+private:
+    std::variant<std::monostate, bool, int64_t, double, HeapObject*> data;
+
+    template <typename Content>
+    constexpr explicit VariantValue(Content content)
+    : data {content}
+    {}
+
+public:
+    constexpr VariantValue()
+    : data {}
+    {}
+
+    static constexpr VariantValue fromBool(bool flag)
+    {
+        return VariantValue {flag};
+    }
+
+    static constexpr VariantValue fromInt(int64_t number)
+    {
+        return VariantValue {number};
+    }
+
+    static constexpr VariantValue fromFloat(double number)
+    {
+        return VariantValue {number};
+    }
+
+    constexpr bool isInt() const
+    {
+        return data.index() == 2;
+    }
+
+    constexpr bool isFloat() const
+    {
+        return data.index() == 3;
+    }
+
+    static constexpr bool areInts(const VariantValue& lhs, const VariantValue& rhs)
+    {
+        return lhs.isInt() && rhs.isInt();
+    }
+
+    uint64_t getIntBits() const
+    {
+        return static_cast<uint64_t>(asInt());
+    }
+
+    bool asBool() const
+    {
+        return *std::get_if<bool>(&data);
+    }
+
+    int64_t asInt() const
+    {
+        return *std::get_if<int64_t>(&data);
+    }
+
+    double asFloat() const
+    {
+        return *std::get_if<double>(&data);
+    }
+
+    double asNumber() const
+    {
+        return isInt() ? static_cast<double>(asInt()) : asFloat();
+    }
+};
+
+/// @note The kernels mirror the VM's VM_ARITHMETIC and VM_COMPARE paths and are kept out of line, so each op pays for its call and tag checks.
+template <typename ValueType>
+[[gnu::noinline]] ValueType addValues(ValueType lhs, ValueType rhs)
+{
+    if (ValueType::areInts(lhs, rhs))
+    {
+        return ValueType::fromInt(static_cast<int64_t>(lhs.getIntBits() + rhs.getIntBits()));
+    }
+
+    return ValueType::fromFloat(lhs.asNumber() + rhs.asNumber());
+}
+
+template <typename ValueType>
+[[gnu::noinline]] ValueType mulValues(ValueType lhs, ValueType rhs)
+{
+    if (ValueType::areInts(lhs, rhs))
+    {
+        return ValueType::fromInt(static_cast<int64_t>(lhs.getIntBits() * rhs.getIntBits()));
+    }
+
+    return ValueType::fromFloat(lhs.asNumber() * rhs.asNumber());
+}
+
+template <typename ValueType>
+[[gnu::noinline]] ValueType lessValues(ValueType lhs, ValueType rhs)
+{
+    if (ValueType::areInts(lhs, rhs))
+    {
+        return ValueType::fromBool(lhs.asInt() < rhs.asInt());
+    }
+
+    return ValueType::fromBool(lhs.asNumber() < rhs.asNumber());
+}
+
+/// @note Final results are stored here so the timed loops cannot be optimized away.
+static volatile double result_sink = 0.0;
+
+static void printTiming(const char* label, std::chrono::steady_clock::time_point start, size_t allocations_before, size_t iterations)
+{
+    double op_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / static_cast<double>(iterations);
+
+    std::cout << "  " << label << ": " << op_ns << " ns/op, " << (allocation_count - allocations_before) << " allocations\n";
+}
+
+/// @brief Times `iterations` of `total = op(total, step)`, like the script loop `total = total + temp`.
+template <typename ValueType, typename Op>
+static void timeArithmetic(const char* label, Op op, ValueType total, ValueType step, size_t iterations)
+{
+    size_t allocations_before = allocation_count;
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t iteration = 0; iteration < iterations; iteration++)
+    {
+        total = op(total, step);
+    }
+
+    printTiming(label, start, allocations_before, iterations);
+    result_sink = total.asNumber();
+}
+
+/// @brief Times `iterations` of comparing alternating ints against a limit, like a loop condition `temp <= n`.
+template <typename ValueType>
+static void timeCompare(const char* label, size_t iterations)
+{
+    const ValueType operands[2] {ValueType::fromInt(1), ValueType::fromInt(3)};
+    const ValueType limit = ValueType::fromInt(2);
+    size_t true_count = 0;
+    size_t allocations_before = allocation_count;
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t iteration = 0; iteration < iterations; iteration++)
+    {
+        true_count += lessValues<ValueType>(operands[iteration & 1], limit).asBool() ? 1 : 0;
+    }
+
+    printTiming(label, start, allocations_before, iterations);
+    result_sink = static_cast<double>(true_count);
+}
+
+template <typename ValueType>
+static void timeAll(const char* name, size_t iterations)
+{
+    std::cout << name << " (" << sizeof(ValueType) << " bytes):\n";
+
+    timeArithmetic<ValueType>("int add", addValues<ValueType>, ValueType::fromInt(0), ValueType::fromInt(3), iterations);
+    timeArithmetic<ValueType>("float add", addValues<ValueType>, ValueType::fromFloat(0.0), ValueType::fromFloat(0.5), iterations);
+    timeArithmetic<ValueType>("int mul", mulValues<ValueType>, ValueType::fromInt(1), ValueType::fromInt(3), iterations);
+    timeCompare<ValueType>("int less", iterations);
+}
+
+int main(int argc, char* argv[])
+{
+    size_t iterations = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : default_iterations;
+
+    timeAll<VariantValue>("std::variant baseline", iterations);
+    timeAll<Value>("NaN-boxed Value", iterations);
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+#ifndef CHUNK_HPP
+#define CHUNK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "backend/opcodes.hpp"
+#include "backend/value.hpp"
+
+namespace fung::backend
+{
+    constexpr uint16_t no_field_shape = 0xffff;
+
+    /**
+     * @brief A field access whose key is a string literal, used by get_field and set_field.
+     * @note When the code generator can tell which object type the receiver has, `shape` is the constant index of that TypeObject and `slot` is the key's slot in it, so a matching receiver is read by index. Otherwise `shape` is no_field_shape and the key is looked up by name.
+     */
+    struct FieldSite
+    {
+        uint16_t key;
+        uint16_t shape;
+        uint16_t slot;
+    };
+
+    constexpr int field_cache_ways = 4;
+
+    /**
+     * @brief Runtime inline cache for one field site, mapping up to field_cache_ways receiver shapes to their slot for the site's key. It is never serialized.
+     * @note A site seeded with a compile-time shape starts with that entry. Once every way is taken the site stops learning, and later new shapes only count as misses.
+     */
+    struct FieldCache
+    {
+        const HeapObject* shapes[field_cache_ways];
+        uint16_t slots[field_cache_ways];
+        uint8_t count;
+        uint64_t hits;
+        uint64_t misses;
+    };
+
+    /**
+     * @brief Bytecode of one function: its instructions, the source offset of each instruction for diagnostics, its constant pool, and its field access sites.
+     */
+    class Chunk
+    {
+    private:
+        std::vector<Instruction> code;
+        std::vector<uint32_t> offsets;
+        std::vector<Value> constants;
+        /// @note Indexes the pool for addConstant(): strings by text, everything else by its boxed bits, so floats match bit for bit and other objects by identity.
+        std::unordered_map<uint64_t, size_t> constant_slots;
+        std::unordered_map<std::string, size_t> string_slots;
+        std::vector<FieldSite> field_sites;
+
+        /// @note Caches are runtime state, so the VM updates them through a const Chunk.
+        mutable std::vector<FieldCache> field_caches;
+
+    public:
+        Chunk();
+
+        /// @return The index of the new instruction, e.g for patching jumps later.
+        size_t emit(Instruction instr, uint32_t source_offset);
+        void patch(size_t index, Instruction instr);
+
+        /// @note Returns the existing slot when the same scalar, string text or object is already pooled.
+        size_t addConstant(const Value& value);
+
+        /**
+         * @brief Adds a field site and its empty cache, seeding the cache with the site's shape if it has one.
+         * @note The site's constants must already be pooled.
+         * @return The site's index, which get_field and set_field take as an 8-bit operand.
+         */
+        size_t addFieldSite(FieldSite site);
+
+        const std::vector<Instruction>& getCode() const;
+        const std::vector<uint32_t>& getOffsets() const;
+        const std::vector<Value>& getConstants() const;
+        std::vector<Value>& getConstants();
+        const std::vector<FieldSite>& getFieldSites() const;
+        std::vector<FieldCache>& getFieldCaches() const;
+    };
+}
+
+#endif
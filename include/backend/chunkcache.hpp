@@ -0,0 +1,47 @@
+#ifndef CHUNKCACHE_HPP
+#define CHUNKCACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "backend/globals.hpp"
+#include "backend/heap.hpp"
+#include "backend/objects.hpp"
+
+namespace fung::backend
+{
+    /**
+     * @note Cache files are little-endian: the magic "FUNGBC\0\0", a u32 format version, the u64 FNV-1a hash of the source, a u32 count of `use` names with each name, then the script function. A function is its name, u8 arity, u8 register count, u16 count of elided nil checks, u8 purity flag, u32 instruction count with each instruction and its source offset, then a u32 constant count with each tagged constant, then a u32 field site count with each site's u16 key, shape and slot, then a u32 count of global names with each name, which the function's get_global and set_global index by Bx. Strings are a u32 length then bytes. The file ends with the u64 FNV-1a hash of everything before it.
+     * @note Bump this whenever the layout or the meaning of generated code changes, so stale caches are rebuilt.
+     */
+    constexpr uint32_t chunk_cache_version = 9;
+
+    enum CacheStatus
+    {
+        cache_ok,
+        cache_stale,
+        cache_corrupt
+    };
+
+    uint64_t hashSource(std::string_view source);
+
+    std::vector<uint8_t> serializeUnit(const FunctionObject& script, const GlobalTable& globals, const std::vector<uint32_t>& module_symbols, uint64_t source_hash);
+
+    /// @brief Checks the magic, version and source hash, then reads and interns the unit's `use` names. On success, body_offset is where deserializeUnit() should start.
+    CacheStatus readCacheHeader(const std::vector<uint8_t>& bytes, uint64_t source_hash, std::vector<uint32_t>& module_symbols, size_t& body_offset);
+
+    /// @return nullptr if the body is malformed or any function fails bytecode verification. Global names are resolved to slots in `globals` as they are read.
+    FunctionObject* deserializeUnit(Heap& heap, GlobalTable& globals, const std::vector<uint8_t>& bytes, size_t body_offset);
+
+    /// @note Gives the cache path for a script, e.g `foo.fung` caches to `foo.fungc`.
+    std::string getCachePath(const std::string& script_path);
+
+    bool readCacheFile(const std::string& path, std::vector<uint8_t>& bytes);
+
+    /// @note Writes through a temporary file and a rename so readers never see a partial cache.
+    bool writeCacheFile(const std::string& path, const std::vector<uint8_t>& bytes);
+}
+
+#endif
@@ -0,0 +1,199 @@
+#ifndef CODEGEN_HPP
+#define CODEGEN_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "frontend/parser.hpp"
+#include "syntax/staticvisitor.hpp"
+#include "backend/globals.hpp"
+#include "backend/heap.hpp"
+#include "backend/objects.hpp"
+
+namespace fung::backend
+{
+    enum CodeGenStatus
+    {
+        codegen_ok,
+        codegen_name_error,
+        codegen_limit_error
+    };
+
+    struct CodeGenDumpState
+    {
+        FunctionObject* script;
+        std::string message;
+        uint32_t error_offset;
+        CodeGenStatus status;
+    };
+
+    /**
+     * @brief Lowers one ProgramUnit into bytecode. The unit's top-level statements become a zero-parameter script function, and each `fun` and `object` declaration becomes a constant that the script binds to a global.
+     * @note Walks the AST through StaticVisitor, so its visitXXX methods mirror StmtVisitor and ExprVisitor but return nothing: expressions write into the register in `dest`.
+     */
+    class CodeGen final : public fung::syntax::StaticVisitor<CodeGen>
+    {
+    private:
+        /// @note A declared object type with its field names' symbols in slot order.
+        struct ShapeInfo
+        {
+            std::vector<uint32_t> field_symbols;
+            TypeObject* type;
+        };
+
+        /// @note `shape` is the object type a `let` local was built from, if known, so literal keys on it resolve to slots. `constant` is the value of a `let` local whose initializer folded, if has_constant is set. `non_nil` is set while the local provably holds a non-nil value at the point being generated. Hidden locals have no_symbol.
+        struct Local
+        {
+            uint32_t symbol;
+            const ShapeInfo* shape;
+            Value constant;
+            uint8_t reg;
+            uint8_t depth;
+            bool is_mutable;
+            bool has_constant;
+            bool non_nil;
+        };
+
+        /**
+         * @note Locals occupy the registers below locals_top and temporaries are stacked above them.
+         * @note `returned` is set once the code being generated can no longer fall through, i.e after a `ret` on every path. `returns_non_nil` stays set while every `ret` seen gives a provably non-nil value.
+         */
+        struct FunctionState
+        {
+            std::vector<Local> locals;
+            FunctionObject* function;
+            uint16_t locals_top;
+            uint16_t next_reg;
+            uint16_t max_reg;
+            uint16_t elided_nil_checks;
+            uint8_t depth;
+            bool returned;
+            bool returns_non_nil;
+        };
+
+        std::unordered_map<uint32_t, bool> global_mutability;
+        std::unordered_map<uint32_t, ShapeInfo> shapes;
+        /// @note Top-level `let` bindings of this unit whose initializers folded, so later reads in the unit skip get_global.
+        std::unordered_map<uint32_t, Value> global_constants;
+        /// @note Immutable globals of this unit known to hold non-nil values: functions, object types and `let` bindings with non-nil initializers.
+        std::unordered_set<uint32_t> non_nil_globals;
+        /// @note Functions of this unit whose every path returns a provably non-nil value.
+        std::unordered_set<uint32_t> non_nil_returns;
+        /// @note Functions of this unit whose parameters are all `val`, the only candidates for purity.
+        std::unordered_map<uint32_t, FunctionObject*> val_functions;
+        Heap& heap;
+        GlobalTable& globals;
+        std::string_view source;
+        FunctionState* state;
+        uint32_t current_offset;
+        uint8_t dest;
+
+        [[noreturn]] void fail(CodeGenStatus status, std::string message) const;
+
+        Chunk& getChunk();
+        size_t emit(Instruction instr);
+        uint16_t addConstant(const Value& value);
+        uint16_t addName(const fung::frontend::Token& token);
+
+        /// @brief Gives the program-wide slot of a global name, so get_global and set_global never look names up at runtime.
+        uint16_t resolveGlobal(const fung::frontend::Token& token);
+        std::string_view getLexeme(const fung::frontend::Token& token) const;
+
+        /// @note Jumps are relative to the instruction after them.
+        void patchJump(size_t jump_index);
+        void emitJumpBack(size_t target_index);
+
+        uint8_t allocReg();
+        bool isTopTemp(uint8_t reg) const;
+
+        const Local* findLocal(uint32_t symbol) const;
+        Local* findLocal(uint32_t symbol);
+        uint8_t declareLocal(const fung::frontend::Token& name, bool is_mutable);
+        void beginScope();
+        void endScope();
+
+        /// @brief Evaluates an expression into the given register, then frees any temporaries it took.
+        void emitExpr(fung::syntax::ExprRef ref, uint8_t target);
+
+        /// @brief Gives a register holding the expression's value: a local's own register if the expression is just its name, otherwise a new temporary.
+        uint8_t emitExprAnywhere(fung::syntax::ExprRef ref);
+
+        /**
+         * @brief Evaluates an expression at compile time if it only combines literals and folded `let` names with operators, mirroring the VM's arithmetic and comparisons.
+         * @note Gives false for anything the VM would raise an error on, e.g integer division by zero, so that error still happens at runtime.
+         */
+        bool tryFold(fung::syntax::ExprRef ref, Value& result) const;
+
+        /**
+         * @brief Tells whether an expression can never evaluate to nil given what is known about locals at this point, e.g literals, arithmetic, comparisons, `?x`, and calls to functions of this unit that never return nil.
+         * @note Used to skip `?` checks that cannot fail.
+         */
+        bool isNonNil(fung::syntax::ExprRef ref) const;
+
+        /// @brief Snapshots the non_nil flag of each live local, so branches can be generated from the same facts and merged after.
+        std::vector<uint8_t> saveNilFacts() const;
+        void restoreNilFacts(const std::vector<uint8_t>& facts);
+
+        /// @brief Keeps only the facts that also hold in `other`, for the join point after a branch.
+        void mergeNilFacts(const std::vector<uint8_t>& other);
+
+        /// @brief Drops facts about the locals a loop body assigns, at the loop head, since the body may reassign them before jumping back.
+        void forgetAssignedNilFacts(const fung::syntax::BlockStmt& body);
+
+        /// @brief Loads a folded scalar or interned string with the shortest instruction that holds it.
+        void emitConstant(const Value& value, uint8_t target);
+
+        /// @brief Gives the shape an expression is known to build: an object literal of a type declared in this unit, or a `let` local holding one.
+        const ShapeInfo* inferShape(fung::syntax::ExprRef ref) const;
+
+        /**
+         * @brief Makes a field site for a string literal key, resolving its slot against the receiver's known shape or else the only declared type with that field.
+         * @return -1 if the key is not a string literal or the function already has 256 sites, so the caller emits a keyed get_index or set_index instead.
+         */
+        int addFieldSite(fung::syntax::ExprRef key, const ShapeInfo* receiver_shape);
+
+        /// @brief Loads the callee into `base` and the arguments above it, then emits `op`, i.e call or tail_call.
+        void emitCall(const fung::syntax::CallExpr& expr, uint8_t base, Opcode op);
+
+        void emitNameLoad(const fung::frontend::Token& name, uint8_t target);
+
+        /// @brief Tells whether a function's bytecode assigns no globals, mutates no lists or objects, and reads only object types and functions not in `impure`.
+        bool isPureBody(const FunctionObject& function, const std::unordered_set<uint32_t>& impure) const;
+
+        /// @brief Marks the unit's pure functions once all are generated, dropping candidates that read an impure function until none change.
+        void markPureFunctions();
+        void emitBlock(const fung::syntax::BlockStmt& block);
+        void emitGlobalBinding(const fung::frontend::Token& name, const Value& value);
+
+    public:
+        CodeGen(Heap& runtime_heap, GlobalTable& global_table, const fung::frontend::ProgramUnit& unit);
+
+        CodeGenDumpState generate(const fung::frontend::ProgramUnit& unit);
+
+        void visitCallExpr(const fung::syntax::CallExpr& expr);
+        void visitElementExpr(const fung::syntax::ElementExpr& expr);
+        void visitAccessExpr(const fung::syntax::AccessExpr& expr);
+        void visitUnaryExpr(const fung::syntax::UnaryExpr& expr);
+        void visitBinaryExpr(const fung::syntax::BinaryExpr& expr);
+
+        void visitUseStmt(const fung::syntax::UseStmt& stmt);
+        void visitVarStmt(const fung::syntax::VarStmt& stmt);
+        void visitParamDecl(const fung::syntax::ParamDecl& stmt);
+        void visitFuncDecl(const fung::syntax::FuncDecl& stmt);
+        void visitFieldDecl(const fung::syntax::FieldDecl& stmt);
+        void visitObjectDecl(const fung::syntax::ObjectDecl& stmt);
+        void visitAssignStmt(const fung::syntax::AssignStmt& stmt);
+        void visitReturnStmt(const fung::syntax::ReturnStmt& stmt);
+        void visitIfStmt(const fung::syntax::IfStmt& stmt);
+        void visitElseStmt(const fung::syntax::ElseStmt& stmt);
+        void visitWhileStmt(const fung::syntax::WhileStmt& stmt);
+        void visitEachStmt(const fung::syntax::EachStmt& stmt);
+        void visitExprStmt(const fung::syntax::ExprStmt& stmt);
+        void visitBlockStmt(const fung::syntax::BlockStmt& stmt);
+    };
+}
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef DISASSEMBLER_HPP
+#define DISASSEMBLER_HPP
+
+#include <iosfwd>
+#include "backend/globals.hpp"
+#include "backend/objects.hpp"
+
+namespace fung::backend
+{
+    /// @brief Prints a function's constants and instructions, then those of every function in its constant pool. Global operands are shown by slot and name.
+    void disassemble(const FunctionObject& function, const GlobalTable& globals, std::ostream& out);
+}
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef GLOBALS_HPP
+#define GLOBALS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "backend/value.hpp"
+
+namespace fung::backend
+{
+    /**
+     * @brief Program-wide table of top-level bindings. The code generator resolves each global name to a fixed slot here, so get_global and set_global index it directly instead of looking up names.
+     * @note A slot exists once any unit mentions its name, but stays undefined until something is stored into it.
+     */
+    class GlobalTable
+    {
+    private:
+        std::unordered_map<uint32_t, uint16_t> slots;
+        std::vector<uint32_t> symbols;
+        std::vector<Value> values;
+        std::vector<uint8_t> defined;
+
+    public:
+        /// @note Slots are the 16-bit Bx operand of get_global and set_global.
+        static constexpr size_t max_globals = 65536;
+
+        GlobalTable();
+
+        GlobalTable(const GlobalTable& other) = delete;
+        GlobalTable& operator=(const GlobalTable& other) = delete;
+
+        /// @return The name's slot, adding an undefined one if needed, or -1 if the table is full.
+        int resolve(uint32_t symbol);
+
+        /// @return -1 if no unit has mentioned the name.
+        int find(uint32_t symbol) const;
+
+        uint32_t getSymbol(uint16_t slot) const;
+        size_t getCount() const;
+
+        bool isDefined(uint16_t slot) const
+        {
+            return defined[slot] != 0;
+        }
+
+        const Value& get(uint16_t slot) const
+        {
+            return values[slot];
+        }
+
+        /// @note Exposed for the collector, which treats every global as a root.
+        std::vector<Value>& getValues()
+        {
+            return values;
+        }
+
+        void set(uint16_t slot, const Value& value)
+        {
+            values[slot] = value;
+            defined[slot] = 1;
+        }
+    };
+}
+
+#endif
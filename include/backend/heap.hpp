@@ -0,0 +1,249 @@
+#ifndef HEAP_HPP
+#define HEAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "backend/objects.hpp"
+
+namespace fung::backend
+{
+    class Heap;
+
+    /// @note Implemented by whatever holds Values outside the heap, i.e the VM, so a collection can find and update them.
+    class GcRootSource
+    {
+    public:
+        virtual ~GcRootSource() = default;
+
+        /// @brief Passes every root Value to Heap::visitRoot(), which may rewrite it to a promoted object.
+        virtual void traceRoots(Heap& heap) = 0;
+    };
+
+    /// @note A pause_budget_us of 0 makes every major GC stop the world until it is done.
+    struct GcConfig
+    {
+        size_t nursery_bytes;
+        size_t old_limit_bytes;
+        uint32_t pause_budget_us;
+    };
+
+    /// @note Pauses are bucketed by upper bound, in microseconds, with a last bucket for anything longer.
+    constexpr uint32_t gc_pause_bucket_limits[] {100, 250, 500, 1000, 2000, 5000};
+    constexpr size_t gc_pause_bucket_count = sizeof(gc_pause_bucket_limits) / sizeof(gc_pause_bucket_limits[0]) + 1;
+
+    struct GcStats
+    {
+        uint64_t pause_buckets[gc_pause_bucket_count];
+        uint64_t minor_count;
+        uint64_t major_count;
+        uint64_t mark_steps;
+        uint64_t total_pause_us;
+        uint64_t max_pause_us;
+        uint64_t bytes_promoted;
+        uint64_t bytes_freed;
+    };
+
+    /**
+     * @brief Owns every runtime object of a program, with a generational collector for the ones the program creates while running.
+     * @note create() makes permanent objects for code: functions, types, natives and interned strings. allocate() bump-allocates strings, lists and instances in the nursery. A minor GC moves the nursery's survivors into the old generation and empties it, and a major GC mark-sweeps the old generation once it outgrows its limit.
+     * @note Collections only happen in collect(), which the VM calls at safepoints once isCollectionDue() is set, so allocating never moves or frees anything.
+     * @note A major GC is incremental: marking and sweeping run in steps of at most the pause budget, one per eighth of the nursery allocated. Between steps the write barrier shades any old object stored into an already marked one, and marking ends with a minor GC and a rescan of the roots, so nothing the program moved behind the marker is lost.
+     */
+    class Heap
+    {
+    private:
+        enum GcPhase : uint8_t
+        {
+            gc_phase_idle,
+            gc_phase_marking,
+            gc_phase_sweeping
+        };
+
+        std::vector<std::unique_ptr<HeapObject>> objects;
+        std::unordered_map<uint32_t, Value> symbol_strings;
+
+        std::unique_ptr<std::max_align_t[]> nursery;
+        std::vector<HeapObject*> nursery_objects;
+        size_t nursery_capacity;
+        size_t nursery_used;
+
+        std::vector<std::unique_ptr<HeapObject>> old_objects;
+        /// @note Old objects that may reference young ones since the last minor GC.
+        std::vector<HeapObject*> remembered;
+        /// @note Promoted objects whose contents the current minor GC has yet to scan.
+        std::vector<HeapObject*> scan_stack;
+        /// @note Marked old objects whose contents the current major GC has yet to scan.
+        std::vector<HeapObject*> mark_stack;
+        size_t old_bytes;
+        size_t old_limit;
+        size_t initial_old_limit;
+
+        /// @note The sweep compacts old_objects in place: survivors move down to sweep_keep as sweep_cursor walks up to sweep_end, the size when sweeping began, so objects promoted meanwhile are left alone.
+        size_t sweep_cursor;
+        size_t sweep_keep;
+        size_t sweep_end;
+        size_t sweep_freed;
+
+        /// @note While a major GC is underway, the nursery fill level at which its next step is due.
+        size_t next_step_at;
+        uint32_t pause_budget_us;
+
+        GcStats stats;
+        GcPhase phase;
+        bool collection_due;
+        bool minor_due;
+        bool minor_active;
+
+        static constexpr size_t nursery_align = 16;
+
+        /// @note Marking and sweeping look at the clock once per this many objects.
+        static constexpr size_t step_check_interval = 128;
+
+        static size_t estimateBytes(const HeapObject& object);
+
+        /// @brief Gives the old copy of a young object, moving it there on first sight.
+        HeapObject* promote(HeapObject* object);
+
+        /// @brief Visits the Values held by one object, i.e rope halves, list items and instance slots.
+        void traceChildren(HeapObject& object);
+        void visitValue(Value& value);
+
+        /// @brief Marks an unmarked old object and queues it for scanning.
+        void shade(HeapObject* object)
+        {
+            if (object->space == heap_space_old && !object->marked)
+            {
+                object->marked = true;
+                mark_stack.push_back(object);
+            }
+        }
+
+        void collectMinor(GcRootSource& roots);
+
+        /// @brief Advances the current major GC until it finishes or `deadline_us` passes, where 0 means no deadline.
+        void stepMajor(GcRootSource& roots, uint64_t start_us, uint64_t deadline_us);
+
+        /// @return false if the deadline passed first.
+        bool drainMarks(uint64_t start_us, uint64_t deadline_us);
+        bool sweepOld(uint64_t start_us, uint64_t deadline_us);
+        void finishSweep();
+        void recordPause(uint64_t pause_us);
+
+        void addOld(std::unique_ptr<HeapObject> object);
+
+    public:
+        static constexpr size_t default_nursery_bytes = 256 << 10;
+        static constexpr size_t default_old_limit_bytes = 16 << 20;
+        static constexpr uint32_t default_pause_budget_us = 1000;
+
+        Heap();
+        ~Heap();
+
+        Heap(const Heap& other) = delete;
+        Heap& operator=(const Heap& other) = delete;
+
+        /// @note Only takes effect while the nursery is empty, i.e before the program runs.
+        void configure(const GcConfig& config);
+
+        template <typename ObjectType, typename... Args>
+        ObjectType* create(Args&&... args)
+        {
+            auto object = std::make_unique<ObjectType>(std::forward<Args>(args)...);
+            ObjectType* object_ptr = object.get();
+
+            objects.emplace_back(std::move(object));
+
+            return object_ptr;
+        }
+
+        /// @brief Makes a collectable object in the nursery, or straight in the old generation if the nursery is full, which also makes a collection due.
+        template <typename ObjectType, typename... Args>
+        ObjectType* allocate(Args&&... args)
+        {
+            constexpr size_t object_size = (sizeof(ObjectType) + nursery_align - 1) & ~(nursery_align - 1);
+
+            if (nursery_used + object_size > nursery_capacity)
+            {
+                auto object = std::make_unique<ObjectType>(std::forward<Args>(args)...);
+                ObjectType* object_ptr = object.get();
+
+                collection_due = true;
+                minor_due = true;
+                addOld(std::move(object));
+
+                return object_ptr;
+            }
+
+            auto* object_ptr = new (reinterpret_cast<std::byte*>(nursery.get()) + nursery_used) ObjectType(std::forward<Args>(args)...);
+
+            static_cast<HeapObject*>(object_ptr)->space = heap_space_young;
+            nursery_used += object_size;
+            nursery_objects.push_back(object_ptr);
+
+            if (nursery_used >= next_step_at)
+            {
+                collection_due = true;
+            }
+
+            return object_ptr;
+        }
+
+        /**
+         * @brief Call after every store into a list or instance.
+         * @note Records an old object that now references a young one, so the next minor GC treats the reference as a root. While marking, also shades an old object stored into a marked one, which the marker may already have scanned.
+         */
+        void writeBarrier(HeapObject* holder, const Value& value)
+        {
+            if (holder->space != heap_space_old || !value.isObject())
+            {
+                return;
+            }
+
+            HeapObject* target = value.asObject();
+
+            if (target->space == heap_space_young)
+            {
+                if (!holder->remembered)
+                {
+                    holder->remembered = true;
+                    remembered.push_back(holder);
+                }
+            }
+            else if (phase == gc_phase_marking && holder->marked)
+            {
+                shade(target);
+            }
+        }
+
+        bool isCollectionDue() const
+        {
+            return collection_due;
+        }
+
+        /// @brief Runs a minor GC if the nursery filled up, then starts a major GC if the old generation is over its limit, and advances any major GC underway within the pause budget.
+        void collect(GcRootSource& roots);
+
+        /// @note For GcRootSource::traceRoots() only.
+        void visitRoot(Value& value);
+
+        Value makeString(std::string text);
+
+        /// @brief Gives the one string object for an interned symbol's text, so equal literals and names across all units share it.
+        Value internString(uint32_t symbol);
+
+        size_t getObjectCount() const;
+        const GcStats& getStats() const;
+
+        /// @brief Prints collection counts, a histogram of pause times, and bytes promoted and freed.
+        void reportStats(std::ostream& out) const;
+    };
+}
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef MEMO_HPP
+#define MEMO_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include "backend/objects.hpp"
+
+namespace fung::backend
+{
+    struct MemoStats
+    {
+        uint64_t hits;
+        uint64_t misses;
+    };
+
+    /**
+     * @brief Bounded cache of pure function results keyed by the callee and its argument values, evicting the least recently used entry when full.
+     * @note Only scalars and strings are cached, as arguments or as results, since those cannot be mutated behind the cache's back.
+     */
+    class MemoTable
+    {
+    private:
+        struct Entry
+        {
+            std::string key;
+            Value result;
+        };
+
+        std::list<Entry> entries;
+        std::unordered_map<std::string, std::list<Entry>::iterator> index;
+        std::unordered_map<const FunctionObject*, MemoStats> stats;
+        size_t capacity;
+        uint64_t evictions;
+
+    public:
+        static constexpr size_t default_capacity = 65536;
+
+        MemoTable(size_t max_entries = default_capacity);
+
+        MemoTable(const MemoTable& other) = delete;
+        MemoTable& operator=(const MemoTable& other) = delete;
+
+        /// @return false if some argument is not a scalar or string, so the call must not be memoized.
+        static bool makeKey(const FunctionObject* function, const Value* args, uint8_t argc, std::string& key);
+
+        /// @brief Looks up a call's result, counting a hit or miss for the function and marking a found entry as most recent.
+        const Value* find(const FunctionObject* function, const std::string& key);
+
+        /// @note Ignores results that are not scalars or strings.
+        void insert(std::string key, const Value& result);
+
+        /// @brief Passes each cached result to the collector as a root.
+        void traceRoots(Heap& heap);
+
+        /// @brief Prints the hit and miss counts of each memoized function, then the totals and evictions.
+        void report(std::ostream& out) const;
+    };
+}
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef NATIVES_HPP
+#define NATIVES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "backend/objects.hpp"
+
+namespace fung::backend
+{
+    struct NativeEntry
+    {
+        const char* name;
+        NativeFn function;
+        uint8_t arity;
+    };
+
+    /// @note A group of natives which `use <name>` brings in, e.g `stdio`. Prelude modules are loaded before any script runs, since older scripts call print() and toString() without `use`.
+    struct NativeModule
+    {
+        const char* name;
+        const NativeEntry* entries;
+        size_t count;
+        bool in_prelude;
+    };
+
+    /// @return nullptr if no native module has that interned name.
+    const NativeModule* findNativeModule(uint32_t name_symbol);
+
+    const NativeModule* getNativeModules();
+    size_t getNativeModuleCount();
+
+    /// @brief Gives the text toString() produces for a value.
+    std::string formatValue(const Value& value);
+}
+
+#endif
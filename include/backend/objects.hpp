@@ -0,0 +1,274 @@
+#ifndef OBJECTS_HPP
+#define OBJECTS_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "backend/chunk.hpp"
+#include "backend/value.hpp"
+
+namespace fung::backend
+{
+    class Heap;
+
+    enum ObjectKind
+    {
+        object_kind_string,
+        object_kind_list,
+        object_kind_instance,
+        object_kind_type,
+        object_kind_function,
+        object_kind_native
+    };
+
+    /// @note Where the collector keeps an object: permanent objects such as functions, types and interned strings are never collected, young ones sit in the nursery until a minor GC, and old ones are mark-swept by a major GC.
+    enum HeapSpace : uint8_t
+    {
+        heap_space_permanent,
+        heap_space_young,
+        heap_space_old
+    };
+
+    /**
+     * @brief Base of all heap-allocated runtime data. The kind tag lets the VM downcast with static_cast.
+     * @note The collector's state lives here: the object's space, its mark for the current major GC, whether an old object is already in the remembered set, and where a young object was promoted to during a minor GC.
+     */
+    class HeapObject
+    {
+    private:
+        friend class Heap;
+
+        HeapObject* forwarded;
+        ObjectKind kind;
+        HeapSpace space;
+        bool marked;
+        bool remembered;
+
+    protected:
+        HeapObject(ObjectKind object_kind)
+        : forwarded {nullptr}, kind {object_kind}, space {heap_space_permanent}, marked {false}, remembered {false}
+        {}
+
+        /// @note Only the collector moves objects, when promoting nursery survivors, so the copy starts with clear collector state.
+        HeapObject(HeapObject&& other) noexcept
+        : forwarded {nullptr}, kind {other.kind}, space {heap_space_permanent}, marked {false}, remembered {false}
+        {}
+
+    public:
+        HeapObject(const HeapObject& other) = delete;
+        HeapObject& operator=(const HeapObject& other) = delete;
+
+        virtual ~HeapObject() = default;
+
+        ObjectKind getKind() const
+        {
+            return kind;
+        }
+
+        HeapSpace getSpace() const
+        {
+            return space;
+        }
+    };
+
+    enum StringForm : uint8_t
+    {
+        string_form_owned,
+        string_form_borrowed,
+        string_form_rope
+    };
+
+    /**
+     * @brief Immutable text in one of three forms: owned, where short text sits inline in std::string's small buffer; borrowed, viewing bytes that outlive the object such as interned literals; or a rope, the lazy concatenation of two other strings.
+     * @note A rope is flattened into owned text the first time its bytes are needed, dropping its halves, so a loop of `s = s + x` costs O(n) overall instead of copying the whole prefix each time.
+     */
+    class StringObject : public HeapObject
+    {
+    private:
+        mutable std::string text;
+        mutable Value left;
+        mutable Value right;
+        mutable const char* data;
+        size_t length;
+        mutable StringForm form;
+
+        void flatten() const;
+
+    public:
+        /// @note Concatenations shorter than this are copied flat, since a rope node costs more than copying a few bytes.
+        static constexpr size_t min_rope_length = 64;
+
+        StringObject(std::string text_value);
+
+        /// @note The bytes are not copied, so they must outlive the object.
+        StringObject(const char* borrowed_data, size_t borrowed_length);
+
+        /// @note Both values must be strings.
+        StringObject(const Value& lhs, const Value& rhs);
+
+        StringObject(StringObject&& other) noexcept;
+
+        std::string_view getText() const;
+
+        /// @note Known without flattening a rope.
+        size_t getLength() const;
+
+        bool isRope() const;
+
+        /// @note Only meaningful while isRope(), for the collector, which may rewrite them to promoted objects.
+        Value& getRopeLeft();
+        Value& getRopeRight();
+
+        /// @note Owned bytes outside the object, for the collector's heap size estimate.
+        size_t getPayloadBytes() const;
+    };
+
+    /// @note What every item of a list is known to be. An empty list counts as ints.
+    enum ListElements : uint8_t
+    {
+        list_elements_ints,
+        list_elements_floats,
+        list_elements_mixed
+    };
+
+    /**
+     * @brief A fixed-length list of Values, tagged with the kind its items share.
+     * @note Since Values are NaN-boxed, an all-float list's items already form a packed double array and an all-int list's a packed array of 48-bit ints, so the tag alone lets a reader skip per-item type checks. The first store of another kind of value drops the tag to mixed for good.
+     */
+    class ListObject : public HeapObject
+    {
+    private:
+        /// @note Declared first so it fits in HeapObject's tail padding.
+        ListElements elements;
+        std::vector<Value> items;
+
+    public:
+        ListObject(std::vector<Value> item_values);
+        ListObject(ListObject&& other) noexcept = default;
+
+        /// @note Stores must go through setItem() so the tag stays true. The collector may still rewrite object items in place, which keeps their kind.
+        std::vector<Value>& getItems();
+        const std::vector<Value>& getItems() const;
+
+        ListElements getElements() const;
+
+        void setItem(size_t index, const Value& value);
+    };
+
+    /**
+     * @brief Runtime form of an ObjectDecl and the shape shared by all of its instances: the type name and its field names in declaration order.
+     * @note A field's slot is its declaration index, so instances of one type lay out their fields identically.
+     */
+    class TypeObject : public HeapObject
+    {
+    private:
+        std::unordered_map<std::string, uint16_t> slots;
+        std::vector<std::string> field_names;
+        std::string name;
+
+    public:
+        TypeObject(std::string type_name, std::vector<std::string> fields);
+
+        const std::string& getName() const;
+        const std::vector<std::string>& getFieldNames() const;
+
+        /// @return -1 if the type has no such field.
+        int findSlot(const std::string& field_name) const;
+    };
+
+    class InstanceObject : public HeapObject
+    {
+    private:
+        std::vector<Value> slots;
+        const TypeObject* type;
+
+    public:
+        /// @note Fields without an initial value start as nil.
+        InstanceObject(const TypeObject* type_info, const Value* initial_values, uint8_t initial_count);
+        InstanceObject(InstanceObject&& other) noexcept = default;
+
+        const TypeObject* getType() const;
+
+        /// @note Indexed by the slots of getType().
+        std::vector<Value>& getSlots();
+        const std::vector<Value>& getSlots() const;
+
+        /// @return nullptr if the type has no such field.
+        Value* findField(const std::string& field_name);
+    };
+
+    class FunctionObject : public HeapObject
+    {
+    private:
+        Chunk chunk;
+        std::string name;
+        uint16_t elided_nil_checks;
+        uint8_t arity;
+        uint8_t register_count;
+        bool pure;
+
+    public:
+        FunctionObject(std::string function_name, uint8_t param_count);
+
+        Chunk& getChunk();
+        const Chunk& getChunk() const;
+        const std::string& getName() const;
+        uint8_t getArity() const;
+
+        /// @note The frame size the VM must reserve, which is at least the arity.
+        uint8_t getRegisterCount() const;
+        void setRegisterCount(uint8_t count);
+
+        /// @note How many `?` checks the code generator proved could never fail and left out.
+        uint16_t getElidedNilChecks() const;
+        void setElidedNilChecks(uint16_t count);
+
+        /// @note Set by the code generator for functions with only `val` parameters that assign no globals, mutate no lists or objects, and call only other pure functions, so their results depend on their arguments alone.
+        bool isPure() const;
+        void setPure(bool flag);
+    };
+
+    /// @note Natives report misuse by throwing RuntimeError.
+    using NativeFn = Value (*)(Heap& heap, const Value* args, uint8_t argc);
+
+    class NativeObject : public HeapObject
+    {
+    private:
+        NativeFn function;
+        const char* name;
+        uint8_t arity;
+
+    public:
+        NativeObject(NativeFn native_fn, const char* native_name, uint8_t param_count);
+
+        NativeFn getFunction() const;
+        const char* getName() const;
+        uint8_t getArity() const;
+    };
+
+    /// @note Checks the tag before downcasting, giving nullptr on a mismatch.
+    template <typename ObjectType, ObjectKind Kind>
+    ObjectType* asObjectOf(const Value& value)
+    {
+        if (!value.isObject() || value.asObject()->getKind() != Kind)
+        {
+            return nullptr;
+        }
+
+        return static_cast<ObjectType*>(value.asObject());
+    }
+
+    inline StringObject* asString(const Value& value)
+    {
+        return asObjectOf<StringObject, object_kind_string>(value);
+    }
+
+    inline ListObject* asList(const Value& value)
+    {
+        return asObjectOf<ListObject, object_kind_list>(value);
+    }
+}
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef OPCODES_HPP
+#define OPCODES_HPP
+
+#include <cstdint>
+
+namespace fung::backend
+{
+    /**
+     * @brief Every instruction is 32 bits: the low byte is the opcode and the rest holds operands in one of three layouts.
+     * @note ABC is `op | A << 8 | B << 16 | C << 24`, ABx puts an unsigned 16-bit Bx where B and C go, and AsBx does the same with a signed sBx. Registers are relative to the current frame's base.
+     */
+    using Instruction = uint32_t;
+
+    enum Opcode : uint8_t
+    {
+        op_nop,             // -
+        op_move,            // R[A] = R[B]
+        op_load_nil,        // R[A] = nil
+        op_load_bool,       // R[A] = (B != 0)
+        op_load_int,        // R[A] = sBx
+        op_load_const,      // R[A] = K[Bx]
+        op_get_global,      // R[A] = globals[Bx], or fail if that slot is undefined
+        op_set_global,      // globals[Bx] = R[A]
+        op_add,             // R[A] = R[B] + R[C]
+        op_add_imm,         // R[A] = R[B] + (int8_t)C
+        op_sub,             // R[A] = R[B] - R[C]
+        op_mul,             // R[A] = R[B] * R[C]
+        op_div,             // R[A] = R[B] / R[C]
+        op_neg,             // R[A] = -R[B]
+        op_nonil,           // R[A] = R[B], or fail if R[B] is nil
+        op_eq,              // R[A] = R[B] == R[C]
+        op_ne,              // R[A] = R[B] != R[C]
+        op_lt,              // R[A] = R[B] < R[C]
+        op_le,              // R[A] = R[B] <= R[C]
+        op_gt,              // R[A] = R[B] > R[C]
+        op_ge,              // R[A] = R[B] >= R[C]
+        op_jump,            // ip += sBx
+        op_jump_if,         // if R[A] then ip += sBx
+        op_jump_if_not,     // if not R[A] then ip += sBx
+        op_new_list,        // R[A] = [R[A + 1], ..., R[A + B]]
+        op_new_object,      // R[A] = R[A] {R[A + 1], ..., R[A + B]} where R[A] holds a type
+        op_get_index,       // R[A] = R[B][R[C]]
+        op_set_index,       // R[A][R[B]] = R[C]
+        op_get_field,       // R[A] = R[B][key of field site C]
+        op_set_field,       // R[A][key of field site B] = R[C]
+        op_len,             // R[A] = item count of R[B]
+        op_call,            // R[A] = R[A](R[A + 1], ..., R[A + B])
+        op_tail_call,       // return R[A](R[A + 1], ..., R[A + B]), reusing this frame for a bytecode callee
+        op_return,          // return R[A] if B != 0, else nil
+        op_last = op_return
+    };
+
+    constexpr int opcode_count = op_last + 1;
+
+    constexpr Instruction encodeABC(Opcode op, uint8_t a, uint8_t b, uint8_t c)
+    {
+        return static_cast<Instruction>(op) | (static_cast<Instruction>(a) << 8) | (static_cast<Instruction>(b) << 16) | (static_cast<Instruction>(c) << 24);
+    }
+
+    constexpr Instruction encodeABx(Opcode op, uint8_t a, uint16_t bx)
+    {
+        return static_cast<Instruction>(op) | (static_cast<Instruction>(a) << 8) | (static_cast<Instruction>(bx) << 16);
+    }
+
+    constexpr Instruction encodeAsBx(Opcode op, uint8_t a, int16_t sbx)
+    {
+        return encodeABx(op, a, static_cast<uint16_t>(sbx));
+    }
+
+    constexpr Opcode decodeOp(Instruction instr)
+    {
+        return static_cast<Opcode>(instr & 0xffu);
+    }
+
+    constexpr uint8_t decodeA(Instruction instr)
+    {
+        return static_cast<uint8_t>(instr >> 8);
+    }
+
+    constexpr uint8_t decodeB(Instruction instr)
+    {
+        return static_cast<uint8_t>(instr >> 16);
+    }
+
+    constexpr uint8_t decodeC(Instruction instr)
+    {
+        return static_cast<uint8_t>(instr >> 24);
+    }
+
+    constexpr uint16_t decodeBx(Instruction instr)
+    {
+        return static_cast<uint16_t>(instr >> 16);
+    }
+
+    constexpr int16_t decodeSBx(Instruction instr)
+    {
+        return static_cast<int16_t>(instr >> 16);
+    }
+
+    const char* getOpcodeName(Opcode op);
+}
+
+#endif
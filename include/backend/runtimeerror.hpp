@@ -0,0 +1,45 @@
+#ifndef RUNTIMEERROR_HPP
+#define RUNTIMEERROR_HPP
+
+#include <string>
+#include <utility>
+
+namespace fung::backend
+{
+    enum VMStatus
+    {
+        vm_status_ok,
+        vm_status_type_error,
+        vm_status_nil_error,
+        vm_status_name_error,
+        vm_status_index_error,
+        vm_status_arity_error,
+        vm_status_math_error,
+        vm_status_stack_overflow
+    };
+
+    /// @note Thrown by the VM and natives, then turned into a VMResult at the top of VM::run.
+    class RuntimeError
+    {
+    private:
+        std::string message;
+        VMStatus status;
+
+    public:
+        RuntimeError(VMStatus error_status, std::string error_message)
+        : message(std::move(error_message)), status {error_status}
+        {}
+
+        VMStatus getStatus() const
+        {
+            return status;
+        }
+
+        const std::string& getMessage() const
+        {
+            return message;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,204 @@
+#ifndef VALUE_HPP
+#define VALUE_HPP
+
+#include <cstdint>
+#include <cstring>
+
+namespace fung::backend
+{
+    class HeapObject;
+
+    enum ValueType
+    {
+        value_type_nil,
+        value_type_bool,
+        value_type_int,
+        value_type_float,
+        value_type_object
+    };
+
+    /// @note Ints are stored inline as 48-bit two's complement, so int arithmetic wraps at these bounds.
+    constexpr int value_int_bits = 48;
+    constexpr int64_t value_int_min = -(int64_t {1} << (value_int_bits - 1));
+    constexpr int64_t value_int_max = (int64_t {1} << (value_int_bits - 1)) - 1;
+
+    /**
+     * @brief Runtime value held in VM registers, globals and constants. Scalars are stored inline and everything else is a HeapObject reference.
+     * @note Values are NaN-boxed in 64 bits. Any bit pattern whose top 13 bits are not all set is a plain double, and NaN results are canonicalized to a positive quiet NaN so they never reach the boxed range. Boxed values keep a 3-bit tag in bits 48-50 and their payload (bool, 48-bit int or object pointer) in the low 48 bits.
+     */
+    class Value
+    {
+    private:
+        static constexpr uint64_t box_bits = 0xFFF8000000000000ull;
+        static constexpr uint64_t payload_mask = 0x0000FFFFFFFFFFFFull;
+        static constexpr uint64_t canonical_nan = 0x7FF8000000000000ull;
+        static constexpr int tag_shift = 48;
+
+        enum BoxTag : uint64_t
+        {
+            box_tag_nil = 1,
+            box_tag_bool = 2,
+            box_tag_int = 3,
+            box_tag_object = 4
+        };
+
+        uint64_t bits;
+
+        static constexpr uint64_t makeBox(BoxTag tag, uint64_t payload)
+        {
+            return box_bits | (static_cast<uint64_t>(tag) << tag_shift) | (payload & payload_mask);
+        }
+
+        constexpr explicit Value(uint64_t raw_bits)
+        : bits {raw_bits}
+        {}
+
+        constexpr bool hasTag(BoxTag tag) const
+        {
+            return (bits >> tag_shift) == (makeBox(tag, 0) >> tag_shift);
+        }
+
+    public:
+        constexpr Value()
+        : bits {makeBox(box_tag_nil, 0)}
+        {}
+
+        static constexpr Value fromBool(bool flag)
+        {
+            return Value {makeBox(box_tag_bool, flag ? 1 : 0)};
+        }
+
+        /// @note Numbers outside [value_int_min, value_int_max] wrap into that range.
+        static constexpr Value fromInt(int64_t number)
+        {
+            return Value {makeBox(box_tag_int, static_cast<uint64_t>(number))};
+        }
+
+        static Value fromFloat(double number)
+        {
+            uint64_t raw_bits = canonical_nan;
+
+            if (number == number)
+            {
+                std::memcpy(&raw_bits, &number, sizeof(raw_bits));
+            }
+
+            return Value {raw_bits};
+        }
+
+        static Value fromObject(HeapObject* object)
+        {
+            return Value {makeBox(box_tag_object, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(object)))};
+        }
+
+        constexpr ValueType getType() const
+        {
+            if ((bits & box_bits) != box_bits)
+            {
+                return value_type_float;
+            }
+
+            switch ((bits >> tag_shift) & 0x7)
+            {
+            case box_tag_nil:
+                return value_type_nil;
+            case box_tag_bool:
+                return value_type_bool;
+            case box_tag_int:
+                return value_type_int;
+            case box_tag_object:
+            default:
+                return value_type_object;
+            }
+        }
+
+        constexpr bool isNil() const
+        {
+            return hasTag(box_tag_nil);
+        }
+
+        constexpr bool isBool() const
+        {
+            return hasTag(box_tag_bool);
+        }
+
+        constexpr bool isInt() const
+        {
+            return hasTag(box_tag_int);
+        }
+
+        /// @note Checks both tags with one compare for the VM's int fast paths.
+        static constexpr bool areInts(const Value& lhs, const Value& rhs)
+        {
+            return (((lhs.bits ^ makeBox(box_tag_int, 0)) | (rhs.bits ^ makeBox(box_tag_int, 0))) >> tag_shift) == 0;
+        }
+
+        constexpr bool isFloat() const
+        {
+            return (bits & box_bits) != box_bits;
+        }
+
+        constexpr bool isNumber() const
+        {
+            return isInt() || isFloat();
+        }
+
+        constexpr bool isObject() const
+        {
+            return hasTag(box_tag_object);
+        }
+
+        /// @note These accessors assume the matching isXXX() check was done.
+        constexpr bool asBool() const
+        {
+            return (bits & 1) != 0;
+        }
+
+        /// @note Sign-extends the 48-bit payload.
+        constexpr int64_t asInt() const
+        {
+            return static_cast<int64_t>(bits << (64 - value_int_bits)) >> (64 - value_int_bits);
+        }
+
+        /// @note Gives an int's raw word. Only its low 48 bits matter and they hold the two's complement payload, so add, sub and mul can work on it directly before fromInt() wraps the result.
+        constexpr uint64_t getIntBits() const
+        {
+            return bits;
+        }
+
+        /// @note Gives the whole boxed word, e.g for keying caches on scalars. Equal scalars of the same type share one word, since NaN is canonicalized.
+        constexpr uint64_t getBits() const
+        {
+            return bits;
+        }
+
+        double asFloat() const
+        {
+            double number = 0.0;
+
+            std::memcpy(&number, &bits, sizeof(number));
+
+            return number;
+        }
+
+        HeapObject* asObject() const
+        {
+            return reinterpret_cast<HeapObject*>(static_cast<uintptr_t>(bits & payload_mask));
+        }
+
+        /// @note Widens ints so mixed arithmetic can use one path.
+        double asNumber() const
+        {
+            return isInt() ? static_cast<double>(asInt()) : asFloat();
+        }
+    };
+
+    static_assert(sizeof(Value) == sizeof(uint64_t), "Value must stay one machine word so scalars never allocate.");
+
+    /// @note Numbers compare by value across int and float, strings by content, and other objects by identity.
+    bool valuesEqual(const Value& lhs, const Value& rhs);
+
+    const char* getValueTypeName(const Value& value);
+}
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef VM_HPP
+#define VM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "backend/globals.hpp"
+#include "backend/heap.hpp"
+#include "backend/memo.hpp"
+#include "backend/natives.hpp"
+#include "backend/objects.hpp"
+#include "backend/runtimeerror.hpp"
+
+namespace fung::backend
+{
+    struct VMResult
+    {
+        Value value;
+        std::string message;
+        const FunctionObject* function;
+        uint32_t source_offset;
+        VMStatus status;
+    };
+
+    /// @note A callee's registers start right after its callee register in the caller's frame, so arguments are already in place as its first locals and the result goes to base[-1].
+    struct CallFrame
+    {
+        const FunctionObject* function;
+        const Instruction* ip;
+        Value* base;
+    };
+
+    /**
+     * @brief Register-based bytecode interpreter. Dispatch uses computed goto on GCC and Clang unless FUNG_NO_COMPUTED_GOTO is defined, and a switch loop otherwise.
+     * @note Bytecode must come from the code generator or a verified cache, since operands are not range checked while running.
+     * @note Garbage is collected at safepoints, i.e calls and backward jumps, once the heap says a collection is due. Every store into a list or instance goes through Heap::writeBarrier().
+     */
+    class VM final : public GcRootSource
+    {
+    private:
+        static constexpr size_t register_capacity = 65536;
+        static constexpr size_t max_frames = 4096;
+
+        Heap& heap;
+        GlobalTable& globals;
+        std::vector<Value> registers;
+        std::vector<CallFrame> frames;
+
+        /// @note A pure call that missed the memo table, waiting for the frame at `depth` (the frame count while it runs) to return its result.
+        struct PendingMemo
+        {
+            std::string key;
+            size_t depth;
+        };
+
+        MemoTable* memo;
+        std::vector<PendingMemo> memo_pending;
+        std::string memo_key;
+
+        Value execute();
+
+        /**
+         * @brief Checks the memo table before a call to a pure function.
+         * @return The cached result, or nullptr after noting a miss to be filled in when the frame at `depth` returns.
+         */
+        const Value* beginMemoCall(const FunctionObject* function, const Value* args, uint8_t argc, size_t depth);
+
+        /// @brief Stores a result for the pending memo entry of the frame that is returning, if it has one.
+        void finishMemoCall(const Value& result);
+
+        Value arithmeticSlow(Opcode op, const Value& lhs, const Value& rhs);
+
+        /// @brief Joins two strings, copying short results and making a rope otherwise.
+        Value concatStrings(const Value& lhs, const StringObject& lhs_text, const Value& rhs, const StringObject& rhs_text);
+        bool compareSlow(Opcode op, const Value& lhs, const Value& rhs);
+        Value getIndex(const Value& target, const Value& key);
+        void setIndex(const Value& target, const Value& key, const Value& value);
+
+        /**
+         * @brief Finds the receiver's slot for a field site through the site's inline cache, filling a free cache entry on a miss.
+         * @return nullptr if the receiver is not an instance or lacks the field, so the caller's keyed lookup reports the error.
+         */
+        Value* findCachedSlot(const Value& target, const FieldSite& site, FieldCache& cache, const Value* consts);
+        Value makeInstance(const Value& type, const Value* initial_values, uint8_t initial_count);
+
+    public:
+        VM(Heap& runtime_heap, GlobalTable& global_table);
+
+        VM(const VM& other) = delete;
+        VM& operator=(const VM& other) = delete;
+
+        void defineGlobal(const std::string& name, const Value& value);
+        const Value* findGlobal(const std::string& name) const;
+        void loadNativeModule(const NativeModule& module);
+        void loadPrelude();
+
+        /// @brief Memoizes calls to pure functions through `table` from now on, or stops if it is nullptr.
+        void setMemoTable(MemoTable* table);
+
+        /// @brief Gives the collector the live registers of all frames, the globals and any memoized results.
+        void traceRoots(Heap& heap) override;
+
+        /// @brief Runs a zero-parameter function such as a unit's top-level code to completion.
+        VMResult run(const FunctionObject* script);
+    };
+}
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef COMPILATION_HPP
+#define COMPILATION_HPP
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "frontend/parser.hpp"
+#include "driver/workerpool.hpp"
+
+namespace fung::driver
+{
+    /// @note Discovered `use` modules sort after every root file.
+    static constexpr size_t unit_order_discovered = static_cast<size_t>(-1);
+
+    /// @note A unit loaded from a valid chunk cache keeps the cache bytes and has no statements, since parsing was skipped.
+    struct UnitResult
+    {
+        std::string path;
+        std::unique_ptr<fung::frontend::ProgramUnit> unit;
+        fung::frontend::ParserDumpState parse_state;
+        /// @note Interned names of the unit's `use` modules, in order.
+        std::vector<uint32_t> module_symbols;
+        /// @note Parallel to module_symbols. Empty where no `<name>.fung` exists, i.e for native modules.
+        std::vector<std::string> module_paths;
+        std::vector<uint8_t> cache_bytes;
+        size_t cache_body_offset;
+        uint64_t source_hash;
+        size_t root_order;
+        bool loaded;
+    };
+
+    /// @note Gives the 1-based line and column of a source offset.
+    std::pair<size_t, size_t> locateOffset(std::string_view source, size_t offset);
+
+    /**
+     * @brief Lexes and parses a set of root scripts plus every script they reach through `use`, one ProgramUnit per file, on a WorkerPool.
+     * @note A `use` name resolves to `<name>.fung` beside the using script. Names without such a file are left for the runtime's built-in modules. With caching on, a unit whose `<path>c` chunk cache matches its source skips lexing and parsing.
+     */
+    class Compilation
+    {
+    private:
+        std::vector<std::unique_ptr<UnitResult>> results;
+        /// @note Every scheduled unit by normalized path, so a root first reached through another unit's `use` still gets its command-line position.
+        std::map<std::string, UnitResult*> scheduled_units;
+        std::mutex results_lock;
+        /// @note Advanced only by addRoot(), so root order never depends on how far the workers have got.
+        size_t root_count;
+        WorkerPool& pool;
+        bool use_cache;
+
+        /// @note Scheduling a path already present only lowers its root order to `root_order` if that is earlier.
+        void schedule(const std::string& path, size_t root_order);
+        void processUnit(UnitResult& result);
+
+    public:
+        Compilation(WorkerPool& worker_pool, bool try_cache);
+
+        void addRoot(const std::string& path);
+
+        /// @brief Waits until the whole `use` closure is parsed, then orders results by root order and then by path so output is deterministic.
+        void run();
+
+        const std::vector<std::unique_ptr<UnitResult>>& getResults() const;
+        bool isCaching() const;
+
+        /// @brief Prints one diagnostic per failed unit in result order. Gives the failure count.
+        size_t reportErrors(std::ostream& out) const;
+    };
+}
+
+#endif
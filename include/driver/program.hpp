@@ -0,0 +1,87 @@
+#ifndef PROGRAM_HPP
+#define PROGRAM_HPP
+
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "backend/globals.hpp"
+#include "backend/heap.hpp"
+#include "backend/memo.hpp"
+#include "backend/vm.hpp"
+#include "driver/compilation.hpp"
+
+namespace fung::driver
+{
+    /// @note A memo_capacity of 0 leaves memoization off.
+    struct ProgramOptions
+    {
+        fung::backend::GcConfig gc_config;
+        size_t memo_capacity;
+        bool write_cache;
+        bool show_disassembly;
+    };
+
+    /**
+     * @brief Turns a finished Compilation into bytecode and runs it on one VM, so all units share globals.
+     */
+    class Program
+    {
+    private:
+        enum UnitState : uint8_t
+        {
+            unit_state_pending,
+            unit_state_started
+        };
+
+        fung::backend::Heap heap;
+        fung::backend::GlobalTable globals;
+        std::unique_ptr<fung::backend::MemoTable> memo;
+        fung::backend::VM vm;
+        std::unordered_map<std::string, size_t> unit_indices;
+        std::unordered_map<const fung::backend::FunctionObject*, size_t> function_units;
+        std::vector<fung::backend::FunctionObject*> scripts;
+        std::vector<UnitState> unit_states;
+        const Compilation& compilation;
+
+        void indexFunctions(const fung::backend::FunctionObject& function, size_t unit_index);
+        void reportAt(std::ostream& out, size_t unit_index, size_t offset, const std::string& message) const;
+
+        void reportFieldCaches(const fung::backend::FunctionObject& function, size_t unit_index, std::ostream& out) const;
+        void reportNilChecks(const fung::backend::FunctionObject& function, const std::string& path, std::ostream& out) const;
+
+        /// @brief Marks every global slot some function assigns, i.e by a top-level binding in any unit.
+        void markAssignedGlobals(const fung::backend::FunctionObject& function, std::vector<uint8_t>& bound) const;
+
+        /// @brief Reports each read of a global that nothing binds. Gives the report count.
+        size_t reportUnresolvedGlobals(const fung::backend::FunctionObject& function, size_t unit_index, const std::vector<uint8_t>& bound, std::ostream& err) const;
+
+        /// @brief Runs the units a unit uses before the unit itself, each at most once.
+        bool runUnit(size_t unit_index, std::ostream& err);
+
+    public:
+        Program(const Compilation& finished_compilation);
+
+        /// @brief Generates code for parsed units, loads cached ones, and checks every `use` and global name resolves. Gives the failure count.
+        size_t build(const ProgramOptions& options, std::ostream& out, std::ostream& err);
+
+        /// @brief Runs the root units in order. Gives false after reporting a runtime error.
+        bool run(std::ostream& err);
+
+        /// @brief Prints the inline cache hit and miss counts of every field site that ran, by source location.
+        void reportFieldCaches(std::ostream& out) const;
+
+        /// @brief Prints how many `?` checks each function kept and how many the code generator elided.
+        void reportNilChecks(std::ostream& out) const;
+
+        /// @brief Prints the memo table's hit and miss counts, if memoization is on.
+        void reportMemo(std::ostream& out) const;
+
+        /// @brief Prints the garbage collector's pause times and bytes promoted and freed.
+        void reportGc(std::ostream& out) const;
+    };
+}
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef WORKERPOOL_HPP
+#define WORKERPOOL_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fung::driver
+{
+    using WorkerTask = std::function<void()>;
+
+    /**
+     * @brief Fixed-size thread pool with one task deque per worker. Workers pop their own newest task first and steal the oldest task of another worker when idle.
+     * @note Tasks submitted from inside a worker go to that worker's deque, which keeps related work (like a unit's `use` dependencies) on a warm cache.
+     */
+    class WorkerPool
+    {
+    private:
+        struct WorkerQueue
+        {
+            std::deque<WorkerTask> tasks;
+            std::mutex lock;
+        };
+
+        std::vector<std::unique_ptr<WorkerQueue>> queues;
+        std::vector<std::thread> workers;
+        std::mutex state_lock;
+        std::condition_variable work_ready;
+        std::condition_variable work_done;
+        size_t pending_count;
+        size_t submit_epoch;
+        size_t next_queue;
+        bool stopping;
+
+        [[nodiscard]] bool popOwn(size_t worker_id, WorkerTask& task);
+        [[nodiscard]] bool stealOther(size_t worker_id, WorkerTask& task);
+        void runWorker(size_t worker_id);
+
+    public:
+        /// @note A worker count of 0 uses the hardware concurrency.
+        WorkerPool(size_t worker_count);
+        ~WorkerPool();
+
+        WorkerPool(const WorkerPool& other) = delete;
+        WorkerPool& operator=(const WorkerPool& other) = delete;
+
+        void submit(WorkerTask task);
+
+        /// @brief Blocks until every submitted task, including ones submitted by tasks, has finished.
+        void waitIdle();
+
+        size_t getWorkerCount() const;
+    };
+}
+
+#endif
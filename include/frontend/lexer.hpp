@@ -1,23 +1,23 @@
 #ifndef LEXER_HPP
 #define LEXER_HPP
 
-#include <string>
-#include <set>
-#include <map>
+#include <string_view>
 #include "frontend/token.hpp"
+#include "frontend/scankernels.hpp"
 
 namespace fung::frontend
 {
     class Lexer
     {
     private:
-        std::map<std::string, TokenType> operators;
-        std::set<std::string> keywords;
         std::string_view source_view;
+        const ScanKernels* kernels;
         size_t position;
         size_t limit;
     public:
         Lexer(const char* source_cstr, size_t source_size);
+        Lexer(std::string_view source);
+        Lexer(const char* source_cstr, size_t source_size, ScanKernelLevel scan_level);
 
         void reset(const char* source_cptr, size_t source_size);
 
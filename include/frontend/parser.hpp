@@ -1,14 +1,13 @@
 #ifndef PARSER_HPP
 #define PARSER_HPP
 
-#include "frontend/lexer.hpp"
+#include <string>
+#include <vector>
+#include "frontend/sourcefile.hpp"
+#include "frontend/tokenbuffer.hpp"
 #include "syntax/expressions.hpp"
-
-// using FungCallExpr = fung::syntax::CallExpr;
-// using FungElemExpr = fung::syntax::ElementExpr;
-// using FungAcssExpr = fung::syntax::AccessExpr;
-// using FungUnryExpr = fung::syntax::UnaryExpr;
-// using FungBnryExpr = fung::syntax::BinaryExpr;
+#include "syntax/exprpool.hpp"
+#include "syntax/statements.hpp"
 
 namespace fung::frontend
 {
@@ -23,44 +22,108 @@ namespace fung::frontend
     {
         Token error_token;
         ParserStatus status;
+        const char* message;
     };
 
     class ProgramUnit
     {
     private:
-        std::vector<std::any> statements;
+        fung::syntax::AstArena arena;
+        fung::syntax::ExprPool exprs;
+        std::vector<fung::syntax::IStmt*> statements;
+        SourceFile source;
         std::string name;
     public:
         ProgramUnit(const std::string& unit_name);
+        ProgramUnit(const std::string& unit_name, SourceFile source_file);
+
+        /// @note All statement nodes of this unit's AST must be created from here.
+        fung::syntax::AstArena& getArena();
+        fung::syntax::ExprPool& getExprPool();
+        const fung::syntax::ExprPool& getExprPool() const;
+        void addStatement(fung::syntax::IStmt* stmt);
 
-        const std::vector<std::any>& getStatements() const;
+        const std::vector<fung::syntax::IStmt*>& getStatements() const;
+        std::string_view getSource() const;
         const std::string& getName() const;
     };
 
+    /**
+     * @brief Recursive descent parser following grammar.md. Statements are created in the arena of the unit being parsed, and expressions in its ExprPool.
+     */
     class Parser
     {
     private:
-        Lexer lexer;
+        TokenBuffer tokens;
+        std::string_view source;
+        fung::syntax::AstArena* arena;
+        fung::syntax::ExprPool* exprs;
+        std::vector<fung::syntax::ExprRef> child_scratch;
+        size_t cursor;
         Token previous;
         Token current;
+        bool lexed_ok;
+
+        void advance();
+        [[nodiscard]] bool match(TokenType type) const;
+        void consume(TokenType type, const char* message);
+
+        template <typename NodeType, typename... Args>
+        NodeType* makeNode(Args&&... args);
+
+        /// @brief Moves the child refs pushed since `scratch_mark` into the pool as one range.
+        fung::syntax::ExprRange commitChildren(size_t scratch_mark);
+
+        template <typename AddStmtFn>
+        void parseBlock(AddStmtFn add_stmt);
+
+        fung::syntax::FungOperatorType toOperator(TokenType type) const;
+
     public:
         Parser(const std::string_view& source_view);
 
-        fung::syntax::ElementExpr parseElement();
+        fung::syntax::ExprRef parseElement();
+
+        fung::syntax::ExprRef parseCall(Token identifier);
+
+        fung::syntax::ExprRef parseAccess();
+
+        fung::syntax::ExprRef parseUnary();
+
+        fung::syntax::ExprRef parseFactor();
+
+        fung::syntax::ExprRef parseTerm();
+
+        fung::syntax::ExprRef parseComparison();
+
+        fung::syntax::ExprRef parseBinary();
+
+        fung::syntax::ExprRef parseExpr();
+
+        fung::syntax::IStmt* parseUse();
+
+        fung::syntax::IStmt* parseVar();
+
+        fung::syntax::IStmt* parseFunc();
+
+        fung::syntax::IStmt* parseObject();
+
+        fung::syntax::IStmt* parseReturn();
+
+        fung::syntax::IStmt* parseIf();
 
-        fung::syntax::CallExpr parseCall();
+        fung::syntax::IStmt* parseWhile();
 
-        fung::syntax::AccessExpr parseAccess();
+        fung::syntax::IStmt* parseEach();
 
-        fung::syntax::UnaryExpr parseUnary();
+        fung::syntax::IStmt* parseAssignOrCall();
 
-        fung::syntax::BinaryExpr parseBinary();
+        fung::syntax::IStmt* parseSubStmt();
 
-        /// TODO Add AST nodes for stmts...
-        /// TODO Add parsing methods for stmts...
+        fung::syntax::IStmt* parseStmt();
 
         ParserDumpState parseFile(ProgramUnit& unit);
     };
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,37 @@
+#ifndef SCANKERNELS_HPP
+#define SCANKERNELS_HPP
+
+#include <cstddef>
+
+namespace fung::frontend
+{
+    /// @note Ordered from least to most capable instruction set.
+    enum ScanKernelLevel
+    {
+        scan_level_scalar,
+        scan_level_sse2,
+        scan_level_avx2
+    };
+
+    /**
+     * @brief Scanning routines used by the Lexer for long runs of bytes. Every routine starts at `position` and gives the index of the first byte that ends the run, or `limit` if none does.
+     */
+    struct ScanKernels
+    {
+        size_t (*skip_whitespace)(const char* data, size_t position, size_t limit);
+        size_t (*skip_alphabetic)(const char* data, size_t position, size_t limit);
+        size_t (*find_byte)(const char* data, size_t position, size_t limit, char target);
+        ScanKernelLevel level;
+    };
+
+    /// @brief Gives the best kernel level this CPU supports, checked once at runtime.
+    [[nodiscard]] ScanKernelLevel detectScanKernelLevel();
+
+    /// @brief Gives the kernels for a level, downgrading it to what the CPU supports.
+    [[nodiscard]] const ScanKernels& getScanKernels(ScanKernelLevel level);
+
+    /// @brief Gives the kernels for the detected level.
+    [[nodiscard]] const ScanKernels& getScanKernels();
+}
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef SOURCEFILE_HPP
+#define SOURCEFILE_HPP
+
+#include <memory>
+#include <string_view>
+
+namespace fung::frontend
+{
+    /**
+     * @brief Owns the bytes of a loaded script. Regular files are memory mapped read-only, while pipes and stdin (the path "-") are read into a heap buffer.
+     * @note The view stays valid until the SourceFile is destroyed or reloaded.
+     */
+    class SourceFile
+    {
+    private:
+        std::unique_ptr<char[]> read_buffer;
+        void* mapping;
+        size_t mapping_size;
+        std::string_view view;
+
+        [[nodiscard]] bool readStream(int fd);
+        void release();
+
+    public:
+        SourceFile();
+        ~SourceFile();
+
+        SourceFile(const SourceFile& other) = delete;
+        SourceFile& operator=(const SourceFile& other) = delete;
+
+        SourceFile(SourceFile&& other) noexcept;
+        SourceFile& operator=(SourceFile&& other) noexcept;
+
+        [[nodiscard]] bool load(const char* path);
+
+        [[nodiscard]] bool isMapped() const;
+        std::string_view getView() const;
+    };
+}
+
+#endif
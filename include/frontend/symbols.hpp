@@ -0,0 +1,25 @@
+#ifndef SYMBOLS_HPP
+#define SYMBOLS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace fung::frontend
+{
+    /// @note Symbol of tokens that are neither identifiers nor string literals.
+    constexpr uint32_t no_symbol = 0;
+
+    /**
+     * @brief Gives the process-wide 32-bit symbol ID of a text, adding it if new. Equal texts always get equal symbols, so later passes compare integers instead of strings.
+     * @note Safe to call from every worker thread at once: the table is split into shards with their own locks, picked by the text's hash.
+     */
+    uint32_t internSymbol(std::string_view text);
+
+    /// @note The view stays valid until exit. Gives an empty view for no_symbol or an unknown ID.
+    std::string_view getSymbolText(uint32_t symbol);
+
+    size_t getSymbolCount();
+}
+
+#endif
@@ -8,6 +8,10 @@
  * 
  */
 
+#ifndef TOKEN_HPP
+#define TOKEN_HPP
+
+#include <cstdint>
 #include <string_view>
 
 namespace fung::frontend
@@ -18,7 +22,21 @@ namespace fung::frontend
         token_bad,
         token_whitespace,
         token_comment,
-        token_keyword,
+        token_keyword_use,
+        token_keyword_let,
+        token_keyword_mut,
+        token_keyword_val,
+        token_keyword_ref,
+        token_keyword_fun,
+        token_keyword_object,
+        token_keyword_field,
+        token_keyword_end,
+        token_keyword_ret,
+        token_keyword_if,
+        token_keyword_else,
+        token_keyword_while,
+        token_keyword_each,
+        token_keyword_in,
         token_identifier,
         token_special_true,
         token_special_false,
@@ -49,14 +67,18 @@ namespace fung::frontend
         token_rbrack
     };
 
+    /// @note `symbol` is the interned ID of an identifier's name or a string literal's contents, and no_symbol for any other token. It sits in what was padding after `type`, so tokens stay the same size.
     struct Token
     {
         size_t begin;
         size_t length;
         TokenType type;
+        uint32_t symbol;
     };
 
     [[nodiscard]] bool testTokenPrintable(const Token& token);
 
     std::string_view stringifyToken(const Token& token, const std::string_view& source);
 }
+
+#endif
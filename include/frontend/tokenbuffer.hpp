@@ -0,0 +1,66 @@
+#ifndef TOKENBUFFER_HPP
+#define TOKENBUFFER_HPP
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "frontend/token.hpp"
+#include "frontend/lexer.hpp"
+
+namespace fung::frontend
+{
+    /// @note Whitespace and comment tokens skipped from the main arrays. `next_token` is the index of the significant token after it.
+    struct TriviaSpan
+    {
+        uint32_t begin;
+        uint32_t length;
+        uint32_t next_token;
+        uint8_t type;
+    };
+
+    /**
+     * @brief Holds every significant token of a source as packed parallel arrays. The last token is always `token_eof`, so lookahead past the end stays at EOF.
+     * @note Lengths that do not fit in 16 bits are marked with `long_length_mark` and kept in a small side table.
+     */
+    class TokenBuffer
+    {
+    private:
+        struct LongLength
+        {
+            uint32_t index;
+            uint32_t length;
+        };
+
+        static constexpr uint16_t long_length_mark = 0xffff;
+
+        std::vector<uint32_t> offsets;
+        std::vector<uint16_t> lengths;
+        std::vector<uint8_t> types;
+        std::vector<uint32_t> symbols;
+        std::vector<LongLength> long_lengths;
+        std::vector<TriviaSpan> trivia;
+
+        void pushToken(const Token& token);
+        void pushTrivia(const Token& token);
+        uint32_t lookupLongLength(size_t index) const;
+
+    public:
+        TokenBuffer();
+
+        /// @brief Lexes all of `source` in one pass, replacing any previous contents. Gives false if the source is too large for 32-bit offsets.
+        [[nodiscard]] bool lexSource(std::string_view source, bool keep_trivia);
+
+        void clear();
+
+        /// @brief Gives the token count including the final EOF.
+        size_t getCount() const;
+
+        /// @brief Gives the token at index, or the EOF token when index is past the end.
+        Token getToken(size_t index) const;
+        TokenType getType(size_t index) const;
+
+        const std::vector<TriviaSpan>& getTrivia() const;
+    };
+}
+
+#endif
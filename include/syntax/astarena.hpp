@@ -0,0 +1,100 @@
+#ifndef ASTARENA_HPP
+#define ASTARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace fung::syntax
+{
+    /**
+     * @brief Bump-pointer allocator for AST nodes. All memory is released at once by release() or destruction, without running any node destructors.
+     * @note Nodes placed here must only own arena memory (e.g ArenaVector) so skipping their destructors leaks nothing.
+     */
+    class AstArena
+    {
+    private:
+        static constexpr size_t default_block_size = 16384;
+
+        std::vector<std::unique_ptr<std::byte[]>> blocks;
+        std::byte* cursor;
+        std::byte* limit;
+        size_t used_bytes;
+
+        void addBlock(size_t min_size);
+
+    public:
+        AstArena();
+
+        AstArena(const AstArena& other) = delete;
+        AstArena& operator=(const AstArena& other) = delete;
+
+        AstArena(AstArena&& other) noexcept;
+        AstArena& operator=(AstArena&& other) noexcept;
+
+        [[nodiscard]] void* allocate(size_t size, size_t alignment);
+
+        template <typename NodeType, typename... Args>
+        NodeType* create(Args&&... args)
+        {
+            void* slot = allocate(sizeof(NodeType), alignof(NodeType));
+
+            return new (slot) NodeType(std::forward<Args>(args)...);
+        }
+
+        void release();
+
+        size_t getUsedBytes() const;
+        size_t getBlockCount() const;
+    };
+
+    /// @brief Standard allocator adaptor over an AstArena. Deallocation is a no-op since the arena frees everything at once.
+    template <typename T>
+    class ArenaAllocator
+    {
+    private:
+        template <typename U>
+        friend class ArenaAllocator;
+
+        AstArena* arena;
+
+    public:
+        using value_type = T;
+
+        ArenaAllocator(AstArena& source_arena) noexcept
+        : arena {&source_arena}
+        {}
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+        : arena {other.arena}
+        {}
+
+        [[nodiscard]] T* allocate(size_t count)
+        {
+            return static_cast<T*>(arena->allocate(count * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T*, size_t) noexcept
+        {}
+
+        template <typename U>
+        bool operator==(const ArenaAllocator<U>& other) const noexcept
+        {
+            return arena == other.arena;
+        }
+
+        template <typename U>
+        bool operator!=(const ArenaAllocator<U>& other) const noexcept
+        {
+            return arena != other.arena;
+        }
+    };
+
+    template <typename T>
+    using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+}
+
+#endif
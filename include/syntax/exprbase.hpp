@@ -6,9 +6,18 @@
 
 namespace fung::syntax
 {
+    /// @note Nodes are move-only so building a tree can never deep-copy one by accident.
     class IExpr
     {
+    protected:
+        IExpr() = default;
+
     public:
+        IExpr(const IExpr& other) = delete;
+        IExpr& operator=(const IExpr& other) = delete;
+        IExpr(IExpr&& other) noexcept = default;
+        IExpr& operator=(IExpr&& other) noexcept = default;
+
         virtual ~IExpr() = default;
 
         virtual std::any accept(ExprVisitor<std::any>& visitor) = 0;
@@ -1,8 +1,8 @@
 #ifndef EXPRESSIONS_HPP
 #define EXPRESSIONS_HPP
 
+#include <cstdint>
 #include <variant>
-#include <vector>
 #include "frontend/token.hpp"
 #include "syntax/exprbase.hpp"
 
@@ -14,6 +14,7 @@ namespace fung::syntax
         fung_simple_type_nil,
         fung_simple_type_bool,
         fung_simple_type_int,
+        fung_simple_type_float,
         fung_simple_type_string,
         fung_simple_type_list,
         fung_simple_type_object
@@ -37,61 +38,137 @@ namespace fung::syntax
         fung_op_logic_or
     };
 
-    class CallExpr : public IExpr
+    /// @note Tags which ExprPool array an ExprRef indexes.
+    enum NestedExprType
+    {
+        nested_expr_call,
+        nested_expr_element,
+        nested_expr_access,
+        nested_expr_unary,
+        nested_expr_binary
+    };
+
+    /// @brief 32-bit handle to an expression node in an ExprPool: the top 3 bits hold its NestedExprType and the rest its index.
+    class ExprRef
     {
     private:
-        std::vector<ElementExpr> args;
-        fung::frontend::Token identifier;
+        static constexpr uint32_t kind_shift = 29;
+        static constexpr uint32_t index_mask = (1u << kind_shift) - 1;
+
+        uint32_t packed;
+
     public:
-        CallExpr(fung::frontend::Token& token);
+        static constexpr uint32_t max_index = index_mask - 1;
+
+        /// @note Gives the null reference e.g for a bare `ret`.
+        constexpr ExprRef()
+        : packed {index_mask}
+        {}
+
+        constexpr ExprRef(NestedExprType kind, uint32_t index)
+        : packed {(static_cast<uint32_t>(kind) << kind_shift) | (index & index_mask)}
+        {}
+
+        constexpr NestedExprType getKind() const
+        {
+            return static_cast<NestedExprType>(packed >> kind_shift);
+        }
+
+        constexpr uint32_t getIndex() const
+        {
+            return packed & index_mask;
+        }
+
+        constexpr bool isNull() const
+        {
+            return (packed & index_mask) == index_mask;
+        }
+
+        constexpr bool operator==(const ExprRef& other) const
+        {
+            return packed == other.packed;
+        }
+
+        constexpr bool operator!=(const ExprRef& other) const
+        {
+            return packed != other.packed;
+        }
+    };
 
-        const fung::frontend::Token& getIdentifierToken() const;
-        void addArgument(const ElementExpr& arg);
-        const std::vector<ElementExpr>& getArguments() const;
+    /// @note Slice of an ExprPool's shared child list e.g call arguments, list items, object fields, or access keys.
+    struct ExprRange
+    {
+        uint32_t start;
+        uint32_t count;
+    };
 
-        std::any accept(ExprVisitor<std::any>& visitor) override;
+    /// @note Content of an object ElementExpr e.g `Foo {0}`, where fields are in declaration order.
+    struct ObjectLiteral
+    {
+        fung::frontend::Token type_name;
+        ExprRange fields;
     };
 
-    /// @todo Maybe add move methods for less copying in vector emplacement?
+    /// @note Nil is monostate, a string holds its inner Token, a list holds the range of its items.
+    using ElementContent = std::variant<std::monostate, bool, int64_t, double, fung::frontend::Token, ExprRange, ObjectLiteral>;
+
+    /**
+     * @brief Literal expression.
+     */
     class ElementExpr : public IExpr
     {
     private:
-        std::any content;
+        ElementContent content;
         FungSimpleType type;
     public:
-        ElementExpr(std::any content_box, FungSimpleType element_type);
+        ElementExpr(ElementContent content_value, FungSimpleType element_type);
 
-        const std::any& getContent() const;
+        const ElementContent& getContent() const;
         FungSimpleType getType() const;
 
         std::any accept(ExprVisitor<std::any>& visitor) override;
     };
 
+    class CallExpr : public IExpr
+    {
+    private:
+        ExprRange args;
+        fung::frontend::Token identifier;
+    public:
+        CallExpr(const fung::frontend::Token& token, ExprRange arg_range);
+
+        const fung::frontend::Token& getIdentifierToken() const;
+        ExprRange getArguments() const;
+
+        std::any accept(ExprVisitor<std::any>& visitor) override;
+    };
+
+    /// @note The lvalue is either a name or a reference to a CallExpr. Keys refer to ElementExprs.
     class AccessExpr : public IExpr
     {
     private:
-        std::vector<ElementExpr> keys;
-        std::variant<fung::frontend::Token, CallExpr> lvalue;
+        ExprRange keys;
+        std::variant<fung::frontend::Token, ExprRef> lvalue;
     public:
-        AccessExpr(fung::frontend::Token& token);
-        AccessExpr(CallExpr& call_expr);
+        AccessExpr(const fung::frontend::Token& token, ExprRange key_range);
+        AccessExpr(ExprRef call_expr, ExprRange key_range);
 
-        void addAccessKey(ElementExpr& key_expr);
-        const std::vector<ElementExpr>& getKeys() const;
-        const std::variant<fung::frontend::Token, CallExpr>& getLvalueVariant() const;
+        ExprRange getKeys() const;
+        const std::variant<fung::frontend::Token, ExprRef>& getLvalueVariant() const;
 
         std::any accept(ExprVisitor<std::any>& visitor) override;
     };
 
+    /// @note The inner expression is an ElementExpr, CallExpr, AccessExpr, or another UnaryExpr.
     class UnaryExpr : public IExpr
     {
     private:
-        AccessExpr inner;
+        ExprRef inner;
         FungOperatorType op;
     public:
-        UnaryExpr(AccessExpr& inner_expr,         FungOperatorType op_type);
+        UnaryExpr(ExprRef inner_expr, FungOperatorType op_type);
 
-        const AccessExpr& getInnerExpr() const;
+        ExprRef getInnerExpr() const;
         FungOperatorType getOperator() const;
 
         std::any accept(ExprVisitor<std::any>& visitor) override;
@@ -100,16 +177,16 @@ namespace fung::syntax
     class BinaryExpr : public IExpr
     {
     private:
-        std::any left;
-        std::any right;
+        ExprRef left;
+        ExprRef right;
         FungOperatorType op;
         bool nests_unaries;
     public:
-        BinaryExpr(UnaryExpr left_expr, UnaryExpr right_expr, FungOperatorType op_symbol);
-        BinaryExpr(BinaryExpr left_expr, BinaryExpr right_expr, FungOperatorType op_symbol);
+        /// @note The unary nesting flag is set when neither side is a BinaryExpr.
+        BinaryExpr(ExprRef left_expr, ExprRef right_expr, FungOperatorType op_symbol);
 
-        const std::any& getLeftExpr() const;
-        const std::any& getRightExpr() const;
+        ExprRef getLeftExpr() const;
+        ExprRef getRightExpr() const;
         FungOperatorType getOperator() const;
         [[nodiscard]] bool isNestingUnaries() const;
 
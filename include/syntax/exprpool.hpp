@@ -0,0 +1,176 @@
+#ifndef EXPRPOOL_HPP
+#define EXPRPOOL_HPP
+
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "syntax/expressions.hpp"
+
+namespace fung::syntax
+{
+    /// @note Read-only view of an ExprRange. Only valid until the pool gets more child lists.
+    class ExprRefSpan
+    {
+    private:
+        const ExprRef* first;
+        uint32_t count;
+
+    public:
+        constexpr ExprRefSpan(const ExprRef* first_ref, uint32_t ref_count)
+        : first {first_ref}, count {ref_count}
+        {}
+
+        constexpr const ExprRef* begin() const
+        {
+            return first;
+        }
+
+        constexpr const ExprRef* end() const
+        {
+            return first + count;
+        }
+
+        constexpr uint32_t size() const
+        {
+            return count;
+        }
+
+        constexpr ExprRef operator[](uint32_t index) const
+        {
+            return first[index];
+        }
+    };
+
+    /**
+     * @brief Flat storage for a unit's expressions: one contiguous array per node kind plus one shared array of child lists. Nodes refer to each other by ExprRef, so walking a tree touches no std::any and needs no virtual calls.
+     */
+    class ExprPool
+    {
+    private:
+        std::vector<CallExpr> calls;
+        std::vector<ElementExpr> elements;
+        std::vector<AccessExpr> accesses;
+        std::vector<UnaryExpr> unaries;
+        std::vector<BinaryExpr> binaries;
+        std::vector<ExprRef> child_refs;
+
+        template <typename NodeType>
+        std::vector<NodeType>& getNodes()
+        {
+            if constexpr (std::is_same_v<NodeType, CallExpr>)
+            {
+                return calls;
+            }
+            else if constexpr (std::is_same_v<NodeType, ElementExpr>)
+            {
+                return elements;
+            }
+            else if constexpr (std::is_same_v<NodeType, AccessExpr>)
+            {
+                return accesses;
+            }
+            else if constexpr (std::is_same_v<NodeType, UnaryExpr>)
+            {
+                return unaries;
+            }
+            else
+            {
+                static_assert(std::is_same_v<NodeType, BinaryExpr>, "ExprPool only stores expression node types.");
+                return binaries;
+            }
+        }
+
+        template <typename NodeType>
+        static constexpr NestedExprType getKindOf()
+        {
+            if constexpr (std::is_same_v<NodeType, CallExpr>)
+            {
+                return nested_expr_call;
+            }
+            else if constexpr (std::is_same_v<NodeType, ElementExpr>)
+            {
+                return nested_expr_element;
+            }
+            else if constexpr (std::is_same_v<NodeType, AccessExpr>)
+            {
+                return nested_expr_access;
+            }
+            else if constexpr (std::is_same_v<NodeType, UnaryExpr>)
+            {
+                return nested_expr_unary;
+            }
+            else
+            {
+                return nested_expr_binary;
+            }
+        }
+
+    public:
+        ExprPool();
+
+        ExprPool(const ExprPool& other) = delete;
+        ExprPool& operator=(const ExprPool& other) = delete;
+        ExprPool(ExprPool&& other) noexcept = default;
+        ExprPool& operator=(ExprPool&& other) noexcept = default;
+
+        /**
+         * @brief Constructs a node in place at the end of its kind's array.
+         * @throws std::length_error when the array is out of ExprRef indices.
+         */
+        template <typename NodeType, typename... Args>
+        ExprRef emplace(Args&&... args)
+        {
+            std::vector<NodeType>& nodes = getNodes<NodeType>();
+
+            if (nodes.size() > ExprRef::max_index)
+            {
+                throw std::length_error {"Too many expression nodes for ExprRef indices."};
+            }
+
+            nodes.emplace_back(std::forward<Args>(args)...);
+
+            return ExprRef {getKindOf<NodeType>(), static_cast<uint32_t>(nodes.size() - 1)};
+        }
+
+        /// @brief Copies a run of child references into the shared child array as one contiguous range.
+        ExprRange addChildren(const ExprRef* refs, size_t count);
+
+        const CallExpr& getCall(ExprRef ref) const;
+        const ElementExpr& getElement(ExprRef ref) const;
+        const AccessExpr& getAccess(ExprRef ref) const;
+        const UnaryExpr& getUnary(ExprRef ref) const;
+        const BinaryExpr& getBinary(ExprRef ref) const;
+        ExprRefSpan getChildren(ExprRange range) const;
+
+        size_t getNodeCount() const;
+        /// @note Counts the bytes reserved by the node and child arrays, including spare capacity.
+        size_t getReservedBytes() const;
+
+        /**
+         * @brief Calls the visitor method matching the node kind. The visitor's static type picks the methods, so a concrete (e.g `final`) visitor gets direct calls.
+         * @note The reference must not be null.
+         */
+        template <typename Visitor>
+        decltype(auto) visit(ExprRef ref, Visitor& visitor) const
+        {
+            switch (ref.getKind())
+            {
+            case nested_expr_call:
+                return visitor.visitCallExpr(calls[ref.getIndex()]);
+            case nested_expr_element:
+                return visitor.visitElementExpr(elements[ref.getIndex()]);
+            case nested_expr_access:
+                return visitor.visitAccessExpr(accesses[ref.getIndex()]);
+            case nested_expr_unary:
+                return visitor.visitUnaryExpr(unaries[ref.getIndex()]);
+            case nested_expr_binary:
+            default:
+                return visitor.visitBinaryExpr(binaries[ref.getIndex()]);
+            }
+        }
+    };
+}
+
+#endif
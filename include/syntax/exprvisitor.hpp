@@ -20,7 +20,7 @@ namespace fung::syntax
     class ExprVisitor
     {
     public:
-        ~ExprVisitor() = default;
+        virtual ~ExprVisitor() = default;
 
         virtual ResultType visitCallExpr(const CallExpr& expr) = 0;
         virtual ResultType visitElementExpr(const ElementExpr& expr) = 0;
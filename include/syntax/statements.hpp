@@ -1,23 +1,26 @@
 #ifndef STATEMENTS_HPP
 #define STATEMENTS_HPP
 
-#include <memory>
 #include <variant>
 #include "frontend/token.hpp"
+#include "syntax/astarena.hpp"
 #include "syntax/expressions.hpp"
 #include "syntax/stmtbase.hpp"
 
-// TODO: finish statement nodes!!
-
+/// @note Every node here is placed in an AstArena and refers to child statements by plain pointers into that arena. Expressions are ExprRefs into the unit's ExprPool.
 namespace fung::syntax
 {
-    enum NestedExprType
+    class BlockStmt : public IStmt
     {
-        nested_expr_call,
-        nested_expr_element,
-        nested_expr_access,
-        nested_expr_unary,
-        nested_expr_binary
+    private:
+        ArenaVector<IStmt*> body;
+    public:
+        BlockStmt(AstArena& arena);
+
+        const ArenaVector<IStmt*>& getBody() const;
+        void addStmt(IStmt* stmt);
+
+        virtual std::any accept(StmtVisitor<std::any>& visitor) override;
     };
 
     class UseStmt : public IStmt
@@ -35,13 +38,13 @@ namespace fung::syntax
     class VarStmt : public IStmt
     {
     private:
-        std::unique_ptr<IExpr> right_expr;
+        ExprRef right_expr;
         fung::frontend::Token identifier;
         bool immutable_flag;
     public:
-        VarStmt(std::unique_ptr<IExpr> expr, const fung::frontend::Token& identifier_token, bool is_let);
+        VarStmt(ExprRef expr, const fung::frontend::Token& identifier_token, bool is_let);
 
-        const std::unique_ptr<IExpr>& getRXpr() const;
+        ExprRef getRXpr() const;
         const fung::frontend::Token& getIdentifier() const;
         bool isImmutable() const;
 
@@ -66,17 +69,18 @@ namespace fung::syntax
     {
     private:
         BlockStmt body;
-        std::vector<ParamDecl> params;
+        ArenaVector<ParamDecl> params;
         fung::frontend::Token name;
 
     public:
-        FuncDecl(const fung::frontend::Token& name_token);
+        FuncDecl(AstArena& arena, const fung::frontend::Token& name_token);
 
-        void addParam(const ParamDecl& param);
-        void addBodyStmt(std::unique_ptr<IStmt> stmt_ptr);
+        /// @note Constructs the parameter directly in the list.
+        void emplaceParam(const fung::frontend::Token& identifier_token, bool is_value);
+        void addBodyStmt(IStmt* stmt_ptr);
 
         const BlockStmt& getBodyBlock() const;
-        const std::vector<ParamDecl>& getParams() const;
+        const ArenaVector<ParamDecl>& getParams() const;
         const fung::frontend::Token& getName() const;
 
         virtual std::any accept(StmtVisitor<std::any>& visitor) override;
@@ -98,13 +102,14 @@ namespace fung::syntax
     class ObjectDecl : public IStmt
     {
     private:
-        std::vector<FieldDecl> fields;
+        ArenaVector<FieldDecl> fields;
         fung::frontend::Token type_name;
     public:
-        ObjectDecl(const fung::frontend::Token& name);
+        ObjectDecl(AstArena& arena, const fung::frontend::Token& name);
 
-        const std::vector<FieldDecl> getFields() const;
-        void addField(const FieldDecl& field);
+        const ArenaVector<FieldDecl>& getFields() const;
+        /// @note Constructs the field directly in the list.
+        void emplaceField(const fung::frontend::Token& field_name);
         const fung::frontend::Token& getName() const;
 
         virtual std::any accept(StmtVisitor<std::any>& visitor) override;
@@ -113,25 +118,27 @@ namespace fung::syntax
     class AssignStmt : public IStmt
     {
     private:
-        AccessExpr var_lvalue;
-        std::unique_ptr<IExpr> var_rvalue;
+        ExprRef var_lvalue;
+        ExprRef var_rvalue;
     public:
-        AssignStmt(AccessExpr lvalue, std::unique_ptr<IExpr> rvalue);
+        /// @note The lvalue always refers to an AccessExpr.
+        AssignStmt(ExprRef lvalue, ExprRef rvalue);
 
-        const AccessExpr& getLValue() const;
-        const std::unique_ptr<IExpr>& getRValue() const;
+        ExprRef getLValue() const;
+        ExprRef getRValue() const;
 
         virtual std::any accept(StmtVisitor<std::any>& visitor) override;
     };
 
+    /// @note A null result means a bare `ret`.
     class ReturnStmt : public IStmt
     {
     private:
-        std::unique_ptr<IExpr> result;
+        ExprRef result;
     public:
-        ReturnStmt(std::unique_ptr<IExpr> result_expr);
+        ReturnStmt(ExprRef result_expr);
 
-        const std::unique_ptr<IExpr>& getResult() const;
+        ExprRef getResult() const;
 
         virtual std::any accept(StmtVisitor<std::any>& visitor) override;
     };
@@ -140,15 +147,15 @@ namespace fung::syntax
     {
     private:
         BlockStmt body;
-        std::unique_ptr<IExpr> conditional;
-        std::unique_ptr<IStmt> other;
+        ExprRef conditional;
+        IStmt* other;
 
     public:
-        IfStmt(BlockStmt block_stmt, std::unique_ptr<IExpr> conditional_expr, std::unique_ptr<IStmt> other_stmt);
+        IfStmt(BlockStmt&& block_stmt, ExprRef conditional_expr, IStmt* other_stmt);
 
         const BlockStmt& getBody() const;
-        const std::unique_ptr<IExpr>& getConditional() const;
-        const std::unique_ptr<IStmt>& getOtherElse() const;
+        ExprRef getConditional() const;
+        IStmt* getOtherElse() const;
 
         virtual std::any accept(StmtVisitor<std::any>& visitor) override;
     };
@@ -158,10 +165,23 @@ namespace fung::syntax
     private:
         BlockStmt body;
     public:
-        ElseStmt();
+        ElseStmt(AstArena& arena);
 
         const BlockStmt& getBody() const;
-        void addStmt(std::unique_ptr<IStmt> stmt);
+        void addStmt(IStmt* stmt);
+
+        virtual std::any accept(StmtVisitor<std::any>& visitor) override;
+    };
+
+    /// @note Only call expressions are allowed as statements.
+    class ExprStmt : public IStmt
+    {
+    private:
+        ExprRef inner;
+    public:
+        ExprStmt(ExprRef inner_expr);
+
+        ExprRef getInner() const;
 
         virtual std::any accept(StmtVisitor<std::any>& visitor) override;
     };
@@ -169,27 +189,31 @@ namespace fung::syntax
     class WhileStmt : public IStmt
     {
     private:
-        std::unique_ptr<IExpr> conditional;
+        ExprRef conditional;
         BlockStmt body;
     public:
-        WhileStmt(std::unique_ptr<IExpr> conditional_expr);
+        WhileStmt(AstArena& arena, ExprRef conditional_expr);
 
-        const std::unique_ptr<IExpr>& getConditional() const;
+        ExprRef getConditional() const;
         const BlockStmt& getBody() const;
-        void addStmt(std::unique_ptr<IStmt> stmt);
+        void addStmt(IStmt* stmt);
 
         virtual std::any accept(StmtVisitor<std::any>& visitor) override;
     };
 
-    class BlockStmt : public IStmt
+    class EachStmt : public IStmt
     {
     private:
-        std::vector<std::unique_ptr<IStmt>> body;
+        ExprRef sequence;
+        BlockStmt body;
+        fung::frontend::Token item_name;
     public:
-        BlockStmt();
+        EachStmt(AstArena& arena, const fung::frontend::Token& item_token, ExprRef sequence_expr);
 
-        const std::vector<std::unique_ptr<IStmt>>& getBody() const;
-        void addStmt(std::unique_ptr<IStmt> stmt);
+        const fung::frontend::Token& getItemName() const;
+        ExprRef getSequence() const;
+        const BlockStmt& getBody() const;
+        void addStmt(IStmt* stmt);
 
         virtual std::any accept(StmtVisitor<std::any>& visitor) override;
     };
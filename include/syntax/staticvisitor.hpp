@@ -0,0 +1,88 @@
+#ifndef STATICVISITOR_HPP
+#define STATICVISITOR_HPP
+
+#include "syntax/exprpool.hpp"
+#include "syntax/statements.hpp"
+
+namespace fung::syntax
+{
+    /**
+     * @brief Calls the visitor method matching the statement's kind tag. Like ExprPool::visit, the visitor's static type picks the methods, so results are returned as-is without std::any.
+     */
+    template <typename Visitor>
+    decltype(auto) visitStmt(const IStmt& stmt, Visitor& visitor)
+    {
+        switch (stmt.getKind())
+        {
+        case nested_stmt_use:
+            return visitor.visitUseStmt(static_cast<const UseStmt&>(stmt));
+        case nested_stmt_var:
+            return visitor.visitVarStmt(static_cast<const VarStmt&>(stmt));
+        case nested_stmt_param:
+            return visitor.visitParamDecl(static_cast<const ParamDecl&>(stmt));
+        case nested_stmt_func:
+            return visitor.visitFuncDecl(static_cast<const FuncDecl&>(stmt));
+        case nested_stmt_field:
+            return visitor.visitFieldDecl(static_cast<const FieldDecl&>(stmt));
+        case nested_stmt_object:
+            return visitor.visitObjectDecl(static_cast<const ObjectDecl&>(stmt));
+        case nested_stmt_assign:
+            return visitor.visitAssignStmt(static_cast<const AssignStmt&>(stmt));
+        case nested_stmt_return:
+            return visitor.visitReturnStmt(static_cast<const ReturnStmt&>(stmt));
+        case nested_stmt_if:
+            return visitor.visitIfStmt(static_cast<const IfStmt&>(stmt));
+        case nested_stmt_else:
+            return visitor.visitElseStmt(static_cast<const ElseStmt&>(stmt));
+        case nested_stmt_while:
+            return visitor.visitWhileStmt(static_cast<const WhileStmt&>(stmt));
+        case nested_stmt_each:
+            return visitor.visitEachStmt(static_cast<const EachStmt&>(stmt));
+        case nested_stmt_expr:
+            return visitor.visitExprStmt(static_cast<const ExprStmt&>(stmt));
+        case nested_stmt_block:
+        default:
+            return visitor.visitBlockStmt(static_cast<const BlockStmt&>(stmt));
+        }
+    }
+
+    /**
+     * @brief CRTP base for passes which want concrete result types e.g a constant folder or code generator. The derived class supplies non-virtual visitXXX methods with the same names as ExprVisitor and StmtVisitor, then recurses through dispatch().
+     * @note Derived classes should be `final` so every visit call is direct and inlinable.
+     * @tparam Derived The pass type.
+     */
+    template <typename Derived>
+    class StaticVisitor
+    {
+    private:
+        const ExprPool* exprs;
+
+        Derived& self()
+        {
+            return static_cast<Derived&>(*this);
+        }
+
+    protected:
+        StaticVisitor(const ExprPool& expr_pool)
+        : exprs {&expr_pool}
+        {}
+
+        const ExprPool& getExprPool() const
+        {
+            return *exprs;
+        }
+
+    public:
+        decltype(auto) dispatch(ExprRef ref)
+        {
+            return exprs->visit(ref, self());
+        }
+
+        decltype(auto) dispatch(const IStmt& stmt)
+        {
+            return visitStmt(stmt, self());
+        }
+    };
+}
+
+#endif
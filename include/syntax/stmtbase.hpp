@@ -6,13 +6,49 @@
 
 namespace fung::syntax
 {
+    /// @note Tags the concrete type of an IStmt so static dispatch can downcast without RTTI.
+    enum NestedStmtType
+    {
+        nested_stmt_use,
+        nested_stmt_var,
+        nested_stmt_param,
+        nested_stmt_func,
+        nested_stmt_field,
+        nested_stmt_object,
+        nested_stmt_assign,
+        nested_stmt_return,
+        nested_stmt_if,
+        nested_stmt_else,
+        nested_stmt_while,
+        nested_stmt_each,
+        nested_stmt_expr,
+        nested_stmt_block
+    };
+
+    /// @note Nodes are move-only so building a tree can never deep-copy one by accident.
     class IStmt
     {
     private:
+        NestedStmtType kind;
+
+    protected:
+        IStmt(NestedStmtType stmt_kind)
+        : kind {stmt_kind}
+        {}
 
     public:
+        IStmt(const IStmt& other) = delete;
+        IStmt& operator=(const IStmt& other) = delete;
+        IStmt(IStmt&& other) noexcept = default;
+        IStmt& operator=(IStmt&& other) noexcept = default;
+
         virtual ~IStmt() = default;
 
+        NestedStmtType getKind() const
+        {
+            return kind;
+        }
+
         virtual std::any accept(StmtVisitor<std::any>& visitor) = 0;
     };
 }
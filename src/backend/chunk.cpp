@@ -0,0 +1,94 @@
+/**
+ * @file chunk.cpp
+ * @author DrkWithT
+ * @brief Implements bytecode chunks.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "backend/objects.hpp"
+#include "backend/chunk.hpp"
+
+namespace fung::backend
+{
+    Chunk::Chunk()
+    : code {}, offsets {}, constants {}, constant_slots {}, string_slots {}, field_sites {}, field_caches {}
+    {}
+
+    size_t Chunk::emit(Instruction instr, uint32_t source_offset)
+    {
+        code.push_back(instr);
+        offsets.push_back(source_offset);
+
+        return code.size() - 1;
+    }
+
+    void Chunk::patch(size_t index, Instruction instr)
+    {
+        code[index] = instr;
+    }
+
+    size_t Chunk::addConstant(const Value& value)
+    {
+        const StringObject* text = asString(value);
+        size_t slot = (text != nullptr)
+            ? string_slots.try_emplace(std::string {text->getText()}, constants.size()).first->second
+            : constant_slots.try_emplace(value.getBits(), constants.size()).first->second;
+
+        if (slot == constants.size())
+        {
+            constants.push_back(value);
+        }
+
+        return slot;
+    }
+
+    size_t Chunk::addFieldSite(FieldSite site)
+    {
+        FieldCache cache {{}, {}, 0, 0, 0};
+
+        if (site.shape != no_field_shape)
+        {
+            cache.shapes[0] = constants[site.shape].asObject();
+            cache.slots[0] = site.slot;
+            cache.count = 1;
+        }
+
+        field_sites.push_back(site);
+        field_caches.push_back(cache);
+
+        return field_sites.size() - 1;
+    }
+
+    const std::vector<Instruction>& Chunk::getCode() const
+    {
+        return code;
+    }
+
+    const std::vector<uint32_t>& Chunk::getOffsets() const
+    {
+        return offsets;
+    }
+
+    const std::vector<Value>& Chunk::getConstants() const
+    {
+        return constants;
+    }
+
+    std::vector<Value>& Chunk::getConstants()
+    {
+        return constants;
+    }
+
+    const std::vector<FieldSite>& Chunk::getFieldSites() const
+    {
+        return field_sites;
+    }
+
+    std::vector<FieldCache>& Chunk::getFieldCaches() const
+    {
+        return field_caches;
+    }
+}
@@ -0,0 +1,743 @@
+/**
+ * @file chunkcache.cpp
+ * @author DrkWithT
+ * @brief Implements the on-disk compiled chunk format.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+#include "frontend/symbols.hpp"
+#include "backend/chunkcache.hpp"
+
+namespace fung::backend
+{
+    static constexpr char cache_magic[8] = {'F', 'U', 'N', 'G', 'B', 'C', '\0', '\0'};
+    static constexpr int max_function_depth = 8;
+
+    enum ConstantTag : uint8_t
+    {
+        constant_tag_nil,
+        constant_tag_bool,
+        constant_tag_int,
+        constant_tag_float,
+        constant_tag_string,
+        constant_tag_function,
+        constant_tag_type,
+        constant_tag_type_ref
+    };
+
+    /// @note Types are written in full once per unit and referenced by index afterwards, so field sites in every function of the unit keep matching the same shape.
+    using TypeIds = std::unordered_map<const TypeObject*, uint32_t>;
+
+    class ByteWriter
+    {
+    private:
+        std::vector<uint8_t>& out;
+
+    public:
+        ByteWriter(std::vector<uint8_t>& output)
+        : out {output}
+        {}
+
+        void writeU8(uint8_t value)
+        {
+            out.push_back(value);
+        }
+
+        void writeU16(uint16_t value)
+        {
+            out.push_back(static_cast<uint8_t>(value));
+            out.push_back(static_cast<uint8_t>(value >> 8));
+        }
+
+        void writeU32(uint32_t value)
+        {
+            for (int byte_i = 0; byte_i < 4; byte_i++)
+            {
+                out.push_back(static_cast<uint8_t>(value >> (byte_i * 8)));
+            }
+        }
+
+        void writeU64(uint64_t value)
+        {
+            for (int byte_i = 0; byte_i < 8; byte_i++)
+            {
+                out.push_back(static_cast<uint8_t>(value >> (byte_i * 8)));
+            }
+        }
+
+        void writeString(std::string_view text)
+        {
+            writeU32(static_cast<uint32_t>(text.size()));
+            out.insert(out.end(), text.begin(), text.end());
+        }
+    };
+
+    /// @note Reads past the end yield zeroes and clear the ok flag, so callers check once at the end of each record.
+    class ByteReader
+    {
+    private:
+        const std::vector<uint8_t>& in;
+        size_t position;
+        bool ok;
+
+        bool require(size_t count)
+        {
+            if (!ok || in.size() - position < count)
+            {
+                ok = false;
+            }
+
+            return ok;
+        }
+
+    public:
+        ByteReader(const std::vector<uint8_t>& input, size_t start)
+        : in {input}, position {start}, ok {start <= input.size()}
+        {}
+
+        uint8_t readU8()
+        {
+            return require(1) ? in[position++] : 0;
+        }
+
+        uint16_t readU16()
+        {
+            if (!require(2))
+            {
+                return 0;
+            }
+
+            uint16_t value = static_cast<uint16_t>(in[position] | (in[position + 1] << 8));
+
+            position += 2;
+
+            return value;
+        }
+
+        uint32_t readU32()
+        {
+            uint32_t value = 0;
+
+            if (!require(4))
+            {
+                return 0;
+            }
+
+            for (int byte_i = 0; byte_i < 4; byte_i++)
+            {
+                value |= static_cast<uint32_t>(in[position++]) << (byte_i * 8);
+            }
+
+            return value;
+        }
+
+        uint64_t readU64()
+        {
+            uint64_t value = 0;
+
+            if (!require(8))
+            {
+                return 0;
+            }
+
+            for (int byte_i = 0; byte_i < 8; byte_i++)
+            {
+                value |= static_cast<uint64_t>(in[position++]) << (byte_i * 8);
+            }
+
+            return value;
+        }
+
+        std::string readString()
+        {
+            uint32_t length = readU32();
+
+            if (!require(length))
+            {
+                return {};
+            }
+
+            std::string text(reinterpret_cast<const char*>(in.data() + position), length);
+
+            position += length;
+
+            return text;
+        }
+
+        bool readMagic()
+        {
+            if (!require(sizeof(cache_magic)))
+            {
+                return false;
+            }
+
+            bool matches = std::memcmp(in.data() + position, cache_magic, sizeof(cache_magic)) == 0;
+
+            position += sizeof(cache_magic);
+
+            return matches;
+        }
+
+        bool isOk() const
+        {
+            return ok;
+        }
+
+        size_t getPosition() const
+        {
+            return position;
+        }
+    };
+
+    /// @note Global slots depend on the order units were compiled in, so get_global and set_global are written with Bx indexing the function's own list of global names instead.
+    static void writeFunction(ByteWriter& writer, const FunctionObject& function, const GlobalTable& globals, TypeIds& type_ids)
+    {
+        const Chunk& chunk = function.getChunk();
+        const auto& code = chunk.getCode();
+        const auto& offsets = chunk.getOffsets();
+        std::unordered_map<uint16_t, uint16_t> global_ids {};
+        std::vector<uint16_t> global_slots {};
+
+        writer.writeString(function.getName());
+        writer.writeU8(function.getArity());
+        writer.writeU8(function.getRegisterCount());
+        writer.writeU16(function.getElidedNilChecks());
+        writer.writeU8(function.isPure() ? 1 : 0);
+        writer.writeU32(static_cast<uint32_t>(code.size()));
+
+        for (size_t instr_i = 0; instr_i < code.size(); instr_i++)
+        {
+            Instruction instr = code[instr_i];
+            Opcode op = decodeOp(instr);
+
+            if (op == op_get_global || op == op_set_global)
+            {
+                auto [global_it, inserted] = global_ids.emplace(decodeBx(instr), static_cast<uint16_t>(global_slots.size()));
+
+                if (inserted)
+                {
+                    global_slots.push_back(decodeBx(instr));
+                }
+
+                instr = encodeABx(op, decodeA(instr), global_it->second);
+            }
+
+            writer.writeU32(instr);
+            writer.writeU32(offsets[instr_i]);
+        }
+
+        writer.writeU32(static_cast<uint32_t>(chunk.getConstants().size()));
+
+        for (const auto& constant : chunk.getConstants())
+        {
+            switch (constant.getType())
+            {
+            case value_type_nil:
+                writer.writeU8(constant_tag_nil);
+                continue;
+            case value_type_bool:
+                writer.writeU8(constant_tag_bool);
+                writer.writeU8(constant.asBool() ? 1 : 0);
+                continue;
+            case value_type_int:
+                writer.writeU8(constant_tag_int);
+                writer.writeU64(static_cast<uint64_t>(constant.asInt()));
+                continue;
+            case value_type_float:
+            {
+                double number = constant.asFloat();
+                uint64_t bits = 0;
+
+                std::memcpy(&bits, &number, sizeof(bits));
+                writer.writeU8(constant_tag_float);
+                writer.writeU64(bits);
+                continue;
+            }
+            case value_type_object:
+            default:
+                break;
+            }
+
+            const HeapObject* object = constant.asObject();
+
+            switch (object->getKind())
+            {
+            case object_kind_string:
+                writer.writeU8(constant_tag_string);
+                writer.writeString(static_cast<const StringObject*>(object)->getText());
+                break;
+            case object_kind_function:
+                writer.writeU8(constant_tag_function);
+                writeFunction(writer, *static_cast<const FunctionObject*>(object), globals, type_ids);
+                break;
+            case object_kind_type:
+            {
+                const auto* type = static_cast<const TypeObject*>(object);
+
+                if (auto type_it = type_ids.find(type); type_it != type_ids.end())
+                {
+                    writer.writeU8(constant_tag_type_ref);
+                    writer.writeU32(type_it->second);
+                    break;
+                }
+
+                type_ids.emplace(type, static_cast<uint32_t>(type_ids.size()));
+                writer.writeU8(constant_tag_type);
+                writer.writeString(type->getName());
+                writer.writeU32(static_cast<uint32_t>(type->getFieldNames().size()));
+
+                for (const auto& field_name : type->getFieldNames())
+                {
+                    writer.writeString(field_name);
+                }
+
+                break;
+            }
+            default:
+                /// @note The code generator only pools the kinds above.
+                writer.writeU8(constant_tag_nil);
+                break;
+            }
+        }
+
+        writer.writeU32(static_cast<uint32_t>(chunk.getFieldSites().size()));
+
+        for (const auto& site : chunk.getFieldSites())
+        {
+            writer.writeU16(site.key);
+            writer.writeU16(site.shape);
+            writer.writeU16(site.slot);
+        }
+
+        writer.writeU32(static_cast<uint32_t>(global_slots.size()));
+
+        for (uint16_t slot : global_slots)
+        {
+            writer.writeString(fung::frontend::getSymbolText(globals.getSymbol(slot)));
+        }
+    }
+
+    static bool isRegister(const FunctionObject& function, uint32_t reg)
+    {
+        return reg < function.getRegisterCount();
+    }
+
+    static bool isJumpTarget(size_t instr_i, int16_t offset, size_t code_size)
+    {
+        long target = static_cast<long>(instr_i) + 1 + offset;
+
+        return target >= 0 && static_cast<size_t>(target) < code_size;
+    }
+
+    static bool isFieldSite(const FunctionObject& function, uint32_t site_index)
+    {
+        return site_index < function.getChunk().getFieldSites().size();
+    }
+
+    /// @brief Checks every operand a cached function could use to make the VM read or jump out of bounds.
+    static bool verifyFunction(const FunctionObject& function, const GlobalTable& globals)
+    {
+        const auto& code = function.getChunk().getCode();
+        const auto& constants = function.getChunk().getConstants();
+
+        if (code.empty() || decodeOp(code.back()) != op_return)
+        {
+            return false;
+        }
+
+        for (const auto& site : function.getChunk().getFieldSites())
+        {
+            if (site.key >= constants.size() || asString(constants[site.key]) == nullptr)
+            {
+                return false;
+            }
+
+            if (site.shape == no_field_shape)
+            {
+                continue;
+            }
+
+            const auto* shape = (site.shape < constants.size()) ? asObjectOf<TypeObject, object_kind_type>(constants[site.shape]) : nullptr;
+
+            if (shape == nullptr || site.slot >= shape->getFieldNames().size())
+            {
+                return false;
+            }
+        }
+
+        for (size_t instr_i = 0; instr_i < code.size(); instr_i++)
+        {
+            Instruction instr = code[instr_i];
+            uint8_t a = decodeA(instr);
+            uint8_t b = decodeB(instr);
+            uint8_t c = decodeC(instr);
+            bool valid = false;
+
+            switch (decodeOp(instr))
+            {
+            case op_nop:
+                valid = true;
+                break;
+            case op_load_nil:
+            case op_load_bool:
+            case op_load_int:
+                valid = isRegister(function, a);
+                break;
+            case op_load_const:
+                valid = isRegister(function, a) && decodeBx(instr) < constants.size();
+                break;
+            case op_get_global:
+            case op_set_global:
+                valid = isRegister(function, a) && decodeBx(instr) < globals.getCount();
+                break;
+            case op_move:
+            case op_add_imm:
+            case op_neg:
+            case op_nonil:
+            case op_len:
+                valid = isRegister(function, a) && isRegister(function, b);
+                break;
+            case op_add:
+            case op_sub:
+            case op_mul:
+            case op_div:
+            case op_eq:
+            case op_ne:
+            case op_lt:
+            case op_le:
+            case op_gt:
+            case op_ge:
+            case op_get_index:
+            case op_set_index:
+                valid = isRegister(function, a) && isRegister(function, b) && isRegister(function, c);
+                break;
+            case op_get_field:
+                valid = isRegister(function, a) && isRegister(function, b) && isFieldSite(function, c);
+                break;
+            case op_set_field:
+                valid = isRegister(function, a) && isFieldSite(function, b) && isRegister(function, c);
+                break;
+            case op_jump:
+                valid = isJumpTarget(instr_i, decodeSBx(instr), code.size());
+                break;
+            case op_jump_if:
+            case op_jump_if_not:
+                valid = isRegister(function, a) && isJumpTarget(instr_i, decodeSBx(instr), code.size());
+                break;
+            case op_new_list:
+            case op_new_object:
+            case op_call:
+            case op_tail_call:
+                valid = isRegister(function, static_cast<uint32_t>(a) + b);
+                break;
+            case op_return:
+                valid = b == 0 || isRegister(function, a);
+                break;
+            default:
+                valid = false;
+                break;
+            }
+
+            if (!valid)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static FunctionObject* readFunction(Heap& heap, GlobalTable& globals, ByteReader& reader, std::vector<TypeObject*>& types, int depth)
+    {
+        if (depth > max_function_depth)
+        {
+            return nullptr;
+        }
+
+        std::string name = reader.readString();
+        uint8_t arity = reader.readU8();
+        uint8_t register_count = reader.readU8();
+        uint16_t elided_nil_checks = reader.readU16();
+        bool pure = reader.readU8() != 0;
+        uint32_t code_count = reader.readU32();
+
+        if (!reader.isOk())
+        {
+            return nullptr;
+        }
+
+        FunctionObject* function = heap.create<FunctionObject>(std::move(name), arity);
+        Chunk& chunk = function->getChunk();
+
+        function->setRegisterCount(register_count);
+        function->setElidedNilChecks(elided_nil_checks);
+        function->setPure(pure);
+
+        for (uint32_t instr_i = 0; instr_i < code_count && reader.isOk(); instr_i++)
+        {
+            Instruction instr = reader.readU32();
+            uint32_t offset = reader.readU32();
+
+            chunk.emit(instr, offset);
+        }
+
+        uint32_t constant_count = reader.readU32();
+        auto& constants = chunk.getConstants();
+
+        for (uint32_t constant_i = 0; constant_i < constant_count && reader.isOk(); constant_i++)
+        {
+            switch (reader.readU8())
+            {
+            case constant_tag_nil:
+                constants.push_back(Value {});
+                break;
+            case constant_tag_bool:
+                constants.push_back(Value::fromBool(reader.readU8() != 0));
+                break;
+            case constant_tag_int:
+                constants.push_back(Value::fromInt(static_cast<int64_t>(reader.readU64())));
+                break;
+            case constant_tag_float:
+            {
+                uint64_t bits = reader.readU64();
+                double number = 0.0;
+
+                std::memcpy(&number, &bits, sizeof(number));
+                constants.push_back(Value::fromFloat(number));
+                break;
+            }
+            case constant_tag_string:
+                constants.push_back(heap.internString(fung::frontend::internSymbol(reader.readString())));
+                break;
+            case constant_tag_function:
+            {
+                FunctionObject* nested = readFunction(heap, globals, reader, types, depth + 1);
+
+                if (nested == nullptr)
+                {
+                    return nullptr;
+                }
+
+                constants.push_back(Value::fromObject(nested));
+                break;
+            }
+            case constant_tag_type:
+            {
+                std::string type_name = reader.readString();
+                uint32_t field_count = reader.readU32();
+                std::vector<std::string> field_names {};
+
+                for (uint32_t field_i = 0; field_i < field_count && reader.isOk(); field_i++)
+                {
+                    field_names.push_back(reader.readString());
+                }
+
+                types.push_back(heap.create<TypeObject>(std::move(type_name), std::move(field_names)));
+                constants.push_back(Value::fromObject(types.back()));
+                break;
+            }
+            case constant_tag_type_ref:
+            {
+                uint32_t type_id = reader.readU32();
+
+                if (type_id >= types.size())
+                {
+                    return nullptr;
+                }
+
+                constants.push_back(Value::fromObject(types[type_id]));
+                break;
+            }
+            default:
+                return nullptr;
+            }
+        }
+
+        uint32_t site_count = reader.readU32();
+
+        for (uint32_t site_i = 0; site_i < site_count && reader.isOk(); site_i++)
+        {
+            uint16_t key = reader.readU16();
+            uint16_t shape = reader.readU16();
+            uint16_t slot = reader.readU16();
+
+            chunk.addFieldSite({key, shape, slot});
+        }
+
+        uint32_t global_count = reader.readU32();
+        std::vector<uint16_t> global_slots {};
+
+        for (uint32_t global_i = 0; global_i < global_count && reader.isOk(); global_i++)
+        {
+            int slot = globals.resolve(fung::frontend::internSymbol(reader.readString()));
+
+            if (slot < 0)
+            {
+                return nullptr;
+            }
+
+            global_slots.push_back(static_cast<uint16_t>(slot));
+        }
+
+        for (size_t instr_i = 0; instr_i < chunk.getCode().size(); instr_i++)
+        {
+            Instruction instr = chunk.getCode()[instr_i];
+            Opcode op = decodeOp(instr);
+
+            if (op != op_get_global && op != op_set_global)
+            {
+                continue;
+            }
+
+            if (decodeBx(instr) >= global_slots.size())
+            {
+                return nullptr;
+            }
+
+            chunk.patch(instr_i, encodeABx(op, decodeA(instr), global_slots[decodeBx(instr)]));
+        }
+
+        if (!reader.isOk() || !verifyFunction(*function, globals))
+        {
+            return nullptr;
+        }
+
+        return function;
+    }
+
+    uint64_t hashSource(std::string_view source)
+    {
+        uint64_t hash = 14695981039346656037ull;
+
+        for (char letter : source)
+        {
+            hash ^= static_cast<uint8_t>(letter);
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    std::vector<uint8_t> serializeUnit(const FunctionObject& script, const GlobalTable& globals, const std::vector<uint32_t>& module_symbols, uint64_t source_hash)
+    {
+        std::vector<uint8_t> bytes {};
+        ByteWriter writer {bytes};
+
+        bytes.insert(bytes.end(), std::begin(cache_magic), std::end(cache_magic));
+        writer.writeU32(chunk_cache_version);
+        writer.writeU64(source_hash);
+        writer.writeU32(static_cast<uint32_t>(module_symbols.size()));
+
+        for (uint32_t module_symbol : module_symbols)
+        {
+            writer.writeString(fung::frontend::getSymbolText(module_symbol));
+        }
+
+        TypeIds type_ids {};
+
+        writeFunction(writer, script, globals, type_ids);
+        writer.writeU64(hashSource({reinterpret_cast<const char*>(bytes.data()), bytes.size()}));
+
+        return bytes;
+    }
+
+    CacheStatus readCacheHeader(const std::vector<uint8_t>& bytes, uint64_t source_hash, std::vector<uint32_t>& module_symbols, size_t& body_offset)
+    {
+        ByteReader reader {bytes, 0};
+
+        if (!reader.readMagic() || bytes.size() < sizeof(cache_magic) + sizeof(uint64_t))
+        {
+            return cache_corrupt;
+        }
+
+        const size_t checksum_offset = bytes.size() - sizeof(uint64_t);
+
+        if (ByteReader {bytes, checksum_offset}.readU64() != hashSource({reinterpret_cast<const char*>(bytes.data()), checksum_offset}))
+        {
+            return cache_corrupt;
+        }
+
+        if (reader.readU32() != chunk_cache_version || reader.readU64() != source_hash)
+        {
+            return reader.isOk() ? cache_stale : cache_corrupt;
+        }
+
+        uint32_t module_count = reader.readU32();
+
+        module_symbols.clear();
+
+        for (uint32_t module_i = 0; module_i < module_count && reader.isOk(); module_i++)
+        {
+            module_symbols.push_back(fung::frontend::internSymbol(reader.readString()));
+        }
+
+        if (!reader.isOk())
+        {
+            return cache_corrupt;
+        }
+
+        body_offset = reader.getPosition();
+
+        return cache_ok;
+    }
+
+    FunctionObject* deserializeUnit(Heap& heap, GlobalTable& globals, const std::vector<uint8_t>& bytes, size_t body_offset)
+    {
+        ByteReader reader {bytes, body_offset};
+
+        std::vector<TypeObject*> types {};
+
+        return readFunction(heap, globals, reader, types, 0);
+    }
+
+    std::string getCachePath(const std::string& script_path)
+    {
+        return script_path + "c";
+    }
+
+    bool readCacheFile(const std::string& path, std::vector<uint8_t>& bytes)
+    {
+        std::ifstream reader {path, std::ios::binary};
+
+        if (!reader.is_open())
+        {
+            return false;
+        }
+
+        bytes.assign(std::istreambuf_iterator<char> {reader}, std::istreambuf_iterator<char> {});
+
+        return !reader.bad();
+    }
+
+    bool writeCacheFile(const std::string& path, const std::vector<uint8_t>& bytes)
+    {
+        std::string temp_path = path + ".tmp";
+
+        {
+            std::ofstream writer {temp_path, std::ios::binary | std::ios::trunc};
+
+            if (!writer.is_open())
+            {
+                return false;
+            }
+
+            writer.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+
+            if (!writer.good())
+            {
+                std::remove(temp_path.c_str());
+                return false;
+            }
+        }
+
+        return std::rename(temp_path.c_str(), path.c_str()) == 0;
+    }
+}
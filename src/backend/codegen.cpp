@@ -0,0 +1,1609 @@
+/**
+ * @file codegen.cpp
+ * @author DrkWithT
+ * @brief Implements the bytecode generator.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <limits>
+#include "backend/codegen.hpp"
+
+namespace fung::backend
+{
+    using namespace fung::syntax;
+    using fung::frontend::Token;
+
+    /// @note Thrown while generating, then turned into a CodeGenDumpState by generate().
+    class CodeGenError
+    {
+    private:
+        std::string message;
+        uint32_t offset;
+        CodeGenStatus status;
+
+    public:
+        CodeGenError(CodeGenStatus error_status, std::string error_message, uint32_t error_offset)
+        : message(std::move(error_message)), offset {error_offset}, status {error_status}
+        {}
+
+        const std::string& getMessage() const
+        {
+            return message;
+        }
+
+        uint32_t getOffset() const
+        {
+            return offset;
+        }
+
+        CodeGenStatus getStatus() const
+        {
+            return status;
+        }
+    };
+
+    static constexpr uint16_t max_registers = 255;
+    static constexpr const char* script_function_name = "<script>";
+
+    static Opcode getBinaryOpcode(FungOperatorType op)
+    {
+        switch (op)
+        {
+        case fung_op_plus:
+            return op_add;
+        case fung_op_minus:
+            return op_sub;
+        case fung_op_times:
+            return op_mul;
+        case fung_op_slash:
+            return op_div;
+        case fung_op_isequal:
+            return op_eq;
+        case fung_op_unequal:
+            return op_ne;
+        case fung_op_lt:
+            return op_lt;
+        case fung_op_gt:
+            return op_gt;
+        case fung_op_lte:
+            return op_le;
+        case fung_op_gte:
+        default:
+            return op_ge;
+        }
+    }
+
+    /// @note Folds only what cannot fail at runtime, producing the same result as VM::arithmeticSlow() and VM::compareSlow().
+    static bool foldBinary(FungOperatorType op, const Value& lhs, const Value& rhs, Value& result)
+    {
+        switch (op)
+        {
+        case fung_op_isequal:
+        case fung_op_unequal:
+            result = Value::fromBool(valuesEqual(lhs, rhs) == (op == fung_op_isequal));
+            return true;
+        case fung_op_lt:
+        case fung_op_gt:
+        case fung_op_lte:
+        case fung_op_gte:
+        {
+            int order = 0;
+
+            if (lhs.isInt() && rhs.isInt())
+            {
+                order = (lhs.asInt() > rhs.asInt()) - (lhs.asInt() < rhs.asInt());
+            }
+            else if (lhs.isNumber() && rhs.isNumber())
+            {
+                order = (lhs.asNumber() > rhs.asNumber()) - (lhs.asNumber() < rhs.asNumber());
+            }
+            else if (asString(lhs) != nullptr && asString(rhs) != nullptr)
+            {
+                int text_order = asString(lhs)->getText().compare(asString(rhs)->getText());
+
+                order = (text_order > 0) - (text_order < 0);
+            }
+            else
+            {
+                return false;
+            }
+
+            bool flag = (op == fung_op_lt) ? order < 0 : (op == fung_op_gt) ? order > 0 : (op == fung_op_lte) ? order <= 0 : order >= 0;
+
+            result = Value::fromBool(flag);
+            return true;
+        }
+        case fung_op_plus:
+        case fung_op_minus:
+        case fung_op_times:
+        case fung_op_slash:
+            break;
+        default:
+            return false;
+        }
+
+        if (!lhs.isNumber() || !rhs.isNumber())
+        {
+            return false;
+        }
+
+        if (lhs.isInt() && rhs.isInt())
+        {
+            uint64_t left = static_cast<uint64_t>(lhs.asInt());
+            uint64_t right = static_cast<uint64_t>(rhs.asInt());
+
+            switch (op)
+            {
+            case fung_op_plus:
+                result = Value::fromInt(static_cast<int64_t>(left + right));
+                return true;
+            case fung_op_minus:
+                result = Value::fromInt(static_cast<int64_t>(left - right));
+                return true;
+            case fung_op_times:
+                result = Value::fromInt(static_cast<int64_t>(left * right));
+                return true;
+            default:
+                if (rhs.asInt() == 0)
+                {
+                    return false;
+                }
+
+                result = Value::fromInt((rhs.asInt() == -1) ? static_cast<int64_t>(0 - left) : lhs.asInt() / rhs.asInt());
+                return true;
+            }
+        }
+
+        double left = lhs.asNumber();
+        double right = rhs.asNumber();
+
+        switch (op)
+        {
+        case fung_op_plus:
+            result = Value::fromFloat(left + right);
+            return true;
+        case fung_op_minus:
+            result = Value::fromFloat(left - right);
+            return true;
+        case fung_op_times:
+            result = Value::fromFloat(left * right);
+            return true;
+        default:
+            result = Value::fromFloat(left / right);
+            return true;
+        }
+    }
+
+    CodeGen::CodeGen(Heap& runtime_heap, GlobalTable& global_table, const fung::frontend::ProgramUnit& unit)
+    : StaticVisitor {unit.getExprPool()}, global_mutability {}, shapes {}, global_constants {}, non_nil_globals {}, non_nil_returns {}, val_functions {}, heap {runtime_heap}, globals {global_table}, source {unit.getSource()}, state {nullptr}, current_offset {0}, dest {0}
+    {}
+
+    void CodeGen::fail(CodeGenStatus status, std::string message) const
+    {
+        throw CodeGenError {status, std::move(message), current_offset};
+    }
+
+    Chunk& CodeGen::getChunk()
+    {
+        return state->function->getChunk();
+    }
+
+    size_t CodeGen::emit(Instruction instr)
+    {
+        return getChunk().emit(instr, current_offset);
+    }
+
+    uint16_t CodeGen::addConstant(const Value& value)
+    {
+        size_t index = getChunk().addConstant(value);
+
+        if (index > std::numeric_limits<uint16_t>::max())
+        {
+            fail(codegen_limit_error, "Too many constants in function " + state->function->getName() + ".");
+        }
+
+        return static_cast<uint16_t>(index);
+    }
+
+    uint16_t CodeGen::addName(const Token& token)
+    {
+        return addConstant(heap.internString(token.symbol));
+    }
+
+    uint16_t CodeGen::resolveGlobal(const Token& token)
+    {
+        int slot = globals.resolve(token.symbol);
+
+        if (slot < 0)
+        {
+            fail(codegen_limit_error, "Too many global names in program.");
+        }
+
+        return static_cast<uint16_t>(slot);
+    }
+
+    std::string_view CodeGen::getLexeme(const Token& token) const
+    {
+        return fung::frontend::stringifyToken(token, source);
+    }
+
+    void CodeGen::patchJump(size_t jump_index)
+    {
+        Chunk& chunk = getChunk();
+        size_t distance = chunk.getCode().size() - (jump_index + 1);
+
+        if (distance > static_cast<size_t>(std::numeric_limits<int16_t>::max()))
+        {
+            fail(codegen_limit_error, "Jump is too long in function " + state->function->getName() + ".");
+        }
+
+        Instruction jump = chunk.getCode()[jump_index];
+
+        chunk.patch(jump_index, encodeAsBx(decodeOp(jump), decodeA(jump), static_cast<int16_t>(distance)));
+    }
+
+    void CodeGen::emitJumpBack(size_t target_index)
+    {
+        size_t distance = getChunk().getCode().size() + 1 - target_index;
+
+        if (distance > static_cast<size_t>(-static_cast<int32_t>(std::numeric_limits<int16_t>::min())))
+        {
+            fail(codegen_limit_error, "Loop body is too long in function " + state->function->getName() + ".");
+        }
+
+        emit(encodeAsBx(op_jump, 0, static_cast<int16_t>(-static_cast<int32_t>(distance))));
+    }
+
+    uint8_t CodeGen::allocReg()
+    {
+        if (state->next_reg >= max_registers)
+        {
+            fail(codegen_limit_error, "Function " + state->function->getName() + " needs too many registers.");
+        }
+
+        uint8_t reg = static_cast<uint8_t>(state->next_reg++);
+
+        if (state->next_reg > state->max_reg)
+        {
+            state->max_reg = state->next_reg;
+        }
+
+        return reg;
+    }
+
+    bool CodeGen::isTopTemp(uint8_t reg) const
+    {
+        return reg >= state->locals_top && reg + 1 == state->next_reg;
+    }
+
+    const CodeGen::Local* CodeGen::findLocal(uint32_t symbol) const
+    {
+        for (auto local_it = state->locals.rbegin(); local_it != state->locals.rend(); local_it++)
+        {
+            if (local_it->symbol == symbol)
+            {
+                return &*local_it;
+            }
+        }
+
+        return nullptr;
+    }
+
+    CodeGen::Local* CodeGen::findLocal(uint32_t symbol)
+    {
+        return const_cast<Local*>(static_cast<const CodeGen&>(*this).findLocal(symbol));
+    }
+
+    uint8_t CodeGen::declareLocal(const Token& name, bool is_mutable)
+    {
+        for (auto local_it = state->locals.rbegin(); local_it != state->locals.rend() && local_it->depth == state->depth; local_it++)
+        {
+            if (local_it->symbol == name.symbol)
+            {
+                fail(codegen_name_error, "Name '" + std::string {getLexeme(name)} + "' is already declared in this scope.");
+            }
+        }
+
+        uint8_t reg = allocReg();
+
+        state->locals.push_back({name.symbol, nullptr, Value {}, reg, state->depth, is_mutable, false, false});
+        state->locals_top = state->next_reg;
+
+        return reg;
+    }
+
+    void CodeGen::beginScope()
+    {
+        state->depth++;
+    }
+
+    void CodeGen::endScope()
+    {
+        state->depth--;
+
+        while (!state->locals.empty() && state->locals.back().depth > state->depth)
+        {
+            state->locals.pop_back();
+        }
+
+        state->locals_top = state->locals.empty() ? 0 : state->locals.back().reg + 1;
+        state->next_reg = state->locals_top;
+    }
+
+    void CodeGen::emitExpr(ExprRef ref, uint8_t target)
+    {
+        uint16_t saved_next_reg = state->next_reg;
+        uint8_t saved_dest = dest;
+
+        dest = target;
+
+        /// @note Literals are left to visitElementExpr(), which also reports out of range ints.
+        if (Value folded {}; ref.getKind() != nested_expr_element && tryFold(ref, folded))
+        {
+            if (ref.getKind() == nested_expr_access)
+            {
+                current_offset = static_cast<uint32_t>(std::get<Token>(getExprPool().getAccess(ref).getLvalueVariant()).begin);
+            }
+
+            emitConstant(folded, target);
+        }
+        else
+        {
+            dispatch(ref);
+        }
+
+        dest = saved_dest;
+        state->next_reg = saved_next_reg;
+    }
+
+    uint8_t CodeGen::emitExprAnywhere(ExprRef ref)
+    {
+        if (ref.getKind() == nested_expr_access)
+        {
+            const AccessExpr& access = getExprPool().getAccess(ref);
+            const auto* name = std::get_if<Token>(&access.getLvalueVariant());
+
+            if (name != nullptr && access.getKeys().count == 0)
+            {
+                if (const Local* local = findLocal(name->symbol); local != nullptr)
+                {
+                    return local->reg;
+                }
+            }
+        }
+
+        uint8_t reg = allocReg();
+
+        emitExpr(ref, reg);
+
+        return reg;
+    }
+
+    bool CodeGen::tryFold(ExprRef ref, Value& result) const
+    {
+        switch (ref.getKind())
+        {
+        case nested_expr_element:
+        {
+            const ElementExpr& element = getExprPool().getElement(ref);
+            const ElementContent& content = element.getContent();
+
+            switch (element.getType())
+            {
+            case fung_simple_type_nil:
+                result = Value {};
+                return true;
+            case fung_simple_type_bool:
+                result = Value::fromBool(std::get<bool>(content));
+                return true;
+            case fung_simple_type_int:
+            {
+                int64_t number = std::get<int64_t>(content);
+
+                /// @note Out of range literals are left for visitElementExpr() to report.
+                if (number < value_int_min || number > value_int_max)
+                {
+                    return false;
+                }
+
+                result = Value::fromInt(number);
+                return true;
+            }
+            case fung_simple_type_float:
+                result = Value::fromFloat(std::get<double>(content));
+                return true;
+            case fung_simple_type_string:
+                result = heap.internString(std::get<Token>(content).symbol);
+                return true;
+            default:
+                return false;
+            }
+        }
+        case nested_expr_access:
+        {
+            const AccessExpr& access = getExprPool().getAccess(ref);
+            const auto* name = std::get_if<Token>(&access.getLvalueVariant());
+
+            if (name == nullptr || access.getKeys().count != 0)
+            {
+                return false;
+            }
+
+            if (const Local* local = findLocal(name->symbol); local != nullptr)
+            {
+                result = local->constant;
+                return local->has_constant;
+            }
+
+            auto constant_it = global_constants.find(name->symbol);
+
+            if (constant_it == global_constants.end())
+            {
+                return false;
+            }
+
+            result = constant_it->second;
+            return true;
+        }
+        case nested_expr_unary:
+        {
+            const UnaryExpr& unary = getExprPool().getUnary(ref);
+            Value inner {};
+
+            if (!tryFold(unary.getInnerExpr(), inner))
+            {
+                return false;
+            }
+
+            if (unary.getOperator() == fung_op_nonil)
+            {
+                result = inner;
+                return !inner.isNil();
+            }
+
+            if (inner.isInt())
+            {
+                result = Value::fromInt(static_cast<int64_t>(0 - static_cast<uint64_t>(inner.asInt())));
+                return true;
+            }
+
+            if (inner.isFloat())
+            {
+                result = Value::fromFloat(-inner.asFloat());
+                return true;
+            }
+
+            return false;
+        }
+        case nested_expr_binary:
+        {
+            const BinaryExpr& binary = getExprPool().getBinary(ref);
+            FungOperatorType op = binary.getOperator();
+            Value lhs {};
+
+            if (!tryFold(binary.getLeftExpr(), lhs))
+            {
+                return false;
+            }
+
+            if (op == fung_op_logic_and || op == fung_op_logic_or)
+            {
+                if (!lhs.isBool())
+                {
+                    return false;
+                }
+
+                if (lhs.asBool() == (op == fung_op_logic_or))
+                {
+                    result = lhs;
+                    return true;
+                }
+
+                return tryFold(binary.getRightExpr(), result);
+            }
+
+            Value rhs {};
+
+            return tryFold(binary.getRightExpr(), rhs) && foldBinary(op, lhs, rhs, result);
+        }
+        default:
+            return false;
+        }
+    }
+
+    bool CodeGen::isNonNil(ExprRef ref) const
+    {
+        if (Value folded {}; tryFold(ref, folded))
+        {
+            return !folded.isNil();
+        }
+
+        switch (ref.getKind())
+        {
+        case nested_expr_element:
+            return getExprPool().getElement(ref).getType() != fung_simple_type_nil;
+        case nested_expr_access:
+        {
+            const AccessExpr& access = getExprPool().getAccess(ref);
+            const auto* name = std::get_if<Token>(&access.getLvalueVariant());
+
+            if (name == nullptr || access.getKeys().count != 0)
+            {
+                return false;
+            }
+
+            if (const Local* local = findLocal(name->symbol); local != nullptr)
+            {
+                return local->non_nil;
+            }
+
+            return non_nil_globals.count(name->symbol) != 0;
+        }
+        case nested_expr_call:
+        {
+            const Token& callee = getExprPool().getCall(ref).getIdentifierToken();
+
+            return findLocal(callee.symbol) == nullptr && non_nil_returns.count(callee.symbol) != 0;
+        }
+        case nested_expr_unary:
+            /// @note Negation and `?` both raise instead of producing nil.
+            return true;
+        case nested_expr_binary:
+        {
+            const BinaryExpr& binary = getExprPool().getBinary(ref);
+
+            /// @note A non-bool left side raises, and a false or true one is itself the result.
+            if (binary.getOperator() == fung_op_logic_and || binary.getOperator() == fung_op_logic_or)
+            {
+                return isNonNil(binary.getRightExpr());
+            }
+
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+
+    std::vector<uint8_t> CodeGen::saveNilFacts() const
+    {
+        std::vector<uint8_t> facts {};
+
+        facts.reserve(state->locals.size());
+
+        for (const auto& local : state->locals)
+        {
+            facts.push_back(local.non_nil ? 1 : 0);
+        }
+
+        return facts;
+    }
+
+    void CodeGen::restoreNilFacts(const std::vector<uint8_t>& facts)
+    {
+        for (size_t local_i = 0; local_i < state->locals.size() && local_i < facts.size(); local_i++)
+        {
+            state->locals[local_i].non_nil = facts[local_i] != 0;
+        }
+    }
+
+    void CodeGen::mergeNilFacts(const std::vector<uint8_t>& other)
+    {
+        for (size_t local_i = 0; local_i < state->locals.size(); local_i++)
+        {
+            state->locals[local_i].non_nil = state->locals[local_i].non_nil && local_i < other.size() && other[local_i] != 0;
+        }
+    }
+
+    void CodeGen::forgetAssignedNilFacts(const BlockStmt& body)
+    {
+        for (const IStmt* stmt : body.getBody())
+        {
+            switch (stmt->getKind())
+            {
+            case nested_stmt_assign:
+            {
+                const AccessExpr& target = getExprPool().getAccess(static_cast<const AssignStmt*>(stmt)->getLValue());
+                const auto* name = std::get_if<Token>(&target.getLvalueVariant());
+
+                if (name == nullptr || target.getKeys().count != 0)
+                {
+                    break;
+                }
+
+                if (Local* local = findLocal(name->symbol); local != nullptr)
+                {
+                    local->non_nil = false;
+                }
+
+                break;
+            }
+            case nested_stmt_if:
+            {
+                const auto* if_stmt = static_cast<const IfStmt*>(stmt);
+
+                forgetAssignedNilFacts(if_stmt->getBody());
+
+                if (if_stmt->getOtherElse() != nullptr)
+                {
+                    forgetAssignedNilFacts(static_cast<const ElseStmt*>(if_stmt->getOtherElse())->getBody());
+                }
+
+                break;
+            }
+            case nested_stmt_while:
+                forgetAssignedNilFacts(static_cast<const WhileStmt*>(stmt)->getBody());
+                break;
+            case nested_stmt_each:
+                forgetAssignedNilFacts(static_cast<const EachStmt*>(stmt)->getBody());
+                break;
+            case nested_stmt_block:
+                forgetAssignedNilFacts(*static_cast<const BlockStmt*>(stmt));
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    void CodeGen::emitConstant(const Value& value, uint8_t target)
+    {
+        if (value.isNil())
+        {
+            emit(encodeABC(op_load_nil, target, 0, 0));
+        }
+        else if (value.isBool())
+        {
+            emit(encodeABC(op_load_bool, target, value.asBool() ? 1 : 0, 0));
+        }
+        else if (value.isInt() && value.asInt() >= std::numeric_limits<int16_t>::min() && value.asInt() <= std::numeric_limits<int16_t>::max())
+        {
+            emit(encodeAsBx(op_load_int, target, static_cast<int16_t>(value.asInt())));
+        }
+        else
+        {
+            emit(encodeABx(op_load_const, target, addConstant(value)));
+        }
+    }
+
+    const CodeGen::ShapeInfo* CodeGen::inferShape(ExprRef ref) const
+    {
+        if (ref.getKind() == nested_expr_access)
+        {
+            const AccessExpr& access = getExprPool().getAccess(ref);
+            const auto* name = std::get_if<Token>(&access.getLvalueVariant());
+
+            if (name == nullptr || access.getKeys().count != 0)
+            {
+                return nullptr;
+            }
+
+            const Local* local = findLocal(name->symbol);
+
+            return (local != nullptr) ? local->shape : nullptr;
+        }
+
+        if (ref.getKind() != nested_expr_element)
+        {
+            return nullptr;
+        }
+
+        const auto* object = std::get_if<ObjectLiteral>(&getExprPool().getElement(ref).getContent());
+
+        if (object == nullptr || findLocal(object->type_name.symbol) != nullptr)
+        {
+            return nullptr;
+        }
+
+        auto shape_it = shapes.find(object->type_name.symbol);
+
+        return (shape_it != shapes.end()) ? &shape_it->second : nullptr;
+    }
+
+    int CodeGen::addFieldSite(ExprRef key, const ShapeInfo* receiver_shape)
+    {
+        if (key.getKind() != nested_expr_element || getChunk().getFieldSites().size() > std::numeric_limits<uint8_t>::max())
+        {
+            return -1;
+        }
+
+        const ElementExpr& element = getExprPool().getElement(key);
+
+        if (element.getType() != fung_simple_type_string)
+        {
+            return -1;
+        }
+
+        const Token& key_token = std::get<Token>(element.getContent());
+        auto findSlot = [&key_token](const ShapeInfo& candidate) {
+            const auto& field_symbols = candidate.field_symbols;
+            auto field_it = std::find(field_symbols.begin(), field_symbols.end(), key_token.symbol);
+
+            return (field_it != field_symbols.end()) ? static_cast<int>(field_it - field_symbols.begin()) : -1;
+        };
+        const ShapeInfo* shape = nullptr;
+        int slot = -1;
+
+        if (receiver_shape != nullptr)
+        {
+            shape = receiver_shape;
+            slot = findSlot(*receiver_shape);
+        }
+        else
+        {
+            /// @note Without a known receiver, a field name declared by exactly one type still pins down the shape.
+            for (const auto& [type_symbol, candidate] : shapes)
+            {
+                int candidate_slot = findSlot(candidate);
+
+                if (candidate_slot < 0)
+                {
+                    continue;
+                }
+
+                if (shape != nullptr)
+                {
+                    slot = -1;
+                    break;
+                }
+
+                shape = &candidate;
+                slot = candidate_slot;
+            }
+        }
+
+        current_offset = static_cast<uint32_t>(key_token.begin);
+
+        FieldSite site {addName(key_token), no_field_shape, 0};
+
+        if (slot >= 0)
+        {
+            site.shape = addConstant(Value::fromObject(shape->type));
+            site.slot = static_cast<uint16_t>(slot);
+        }
+
+        return static_cast<int>(getChunk().addFieldSite(site));
+    }
+
+    void CodeGen::emitCall(const CallExpr& expr, uint8_t base, Opcode op)
+    {
+        ExprRefSpan args = getExprPool().getChildren(expr.getArguments());
+
+        if (args.size() > max_registers)
+        {
+            fail(codegen_limit_error, "Too many call arguments.");
+        }
+
+        emitNameLoad(expr.getIdentifierToken(), base);
+
+        for (ExprRef arg : args)
+        {
+            emitExpr(arg, allocReg());
+        }
+
+        current_offset = static_cast<uint32_t>(expr.getIdentifierToken().begin);
+        emit(encodeABC(op, base, static_cast<uint8_t>(args.size()), 0));
+    }
+
+    void CodeGen::emitNameLoad(const Token& name, uint8_t target)
+    {
+        current_offset = static_cast<uint32_t>(name.begin);
+
+        if (const Local* local = findLocal(name.symbol); local != nullptr)
+        {
+            if (local->reg != target)
+            {
+                emit(encodeABC(op_move, target, local->reg, 0));
+            }
+
+            return;
+        }
+
+        emit(encodeABx(op_get_global, target, resolveGlobal(name)));
+    }
+
+    void CodeGen::emitBlock(const BlockStmt& block)
+    {
+        beginScope();
+
+        for (const IStmt* stmt : block.getBody())
+        {
+            dispatch(*stmt);
+        }
+
+        endScope();
+    }
+
+    void CodeGen::emitGlobalBinding(const Token& name, const Value& value)
+    {
+        current_offset = static_cast<uint32_t>(name.begin);
+
+        uint8_t reg = allocReg();
+
+        emit(encodeABx(op_load_const, reg, addConstant(value)));
+        emit(encodeABx(op_set_global, reg, resolveGlobal(name)));
+        non_nil_globals.insert(name.symbol);
+
+        state->next_reg--;
+    }
+
+    bool CodeGen::isPureBody(const FunctionObject& function, const std::unordered_set<uint32_t>& impure) const
+    {
+        for (Instruction instr : function.getChunk().getCode())
+        {
+            switch (decodeOp(instr))
+            {
+            case op_set_global:
+            case op_set_index:
+            case op_set_field:
+                return false;
+            case op_get_global:
+            {
+                uint32_t symbol = globals.getSymbol(decodeBx(instr));
+
+                if (shapes.count(symbol) == 0 && (val_functions.count(symbol) == 0 || impure.count(symbol) != 0))
+                {
+                    return false;
+                }
+
+                break;
+            }
+            default:
+                break;
+            }
+        }
+
+        return true;
+    }
+
+    void CodeGen::markPureFunctions()
+    {
+        std::unordered_set<uint32_t> impure {};
+        bool changed = true;
+
+        while (changed)
+        {
+            changed = false;
+
+            for (const auto& [symbol, function] : val_functions)
+            {
+                if (impure.count(symbol) == 0 && !isPureBody(*function, impure))
+                {
+                    impure.insert(symbol);
+                    changed = true;
+                }
+            }
+        }
+
+        for (const auto& [symbol, function] : val_functions)
+        {
+            function->setPure(impure.count(symbol) == 0);
+        }
+    }
+
+    CodeGenDumpState CodeGen::generate(const fung::frontend::ProgramUnit& unit)
+    {
+        FunctionObject* script = heap.create<FunctionObject>(script_function_name, 0);
+        FunctionState script_state {{}, script, 0, 0, 0, 0, 0, false, true};
+
+        state = &script_state;
+
+        try
+        {
+            /// @note Shapes are made up front so functions declared before an object can still resolve its fields.
+            for (const IStmt* stmt : unit.getStatements())
+            {
+                if (stmt->getKind() != nested_stmt_object)
+                {
+                    continue;
+                }
+
+                const auto& object = static_cast<const ObjectDecl&>(*stmt);
+                std::vector<std::string> field_names {};
+                std::vector<uint32_t> field_symbols {};
+
+                for (const auto& field : object.getFields())
+                {
+                    field_names.emplace_back(getLexeme(field.getName()));
+                    field_symbols.push_back(field.getName().symbol);
+                }
+
+                std::string type_name {getLexeme(object.getName())};
+
+                current_offset = static_cast<uint32_t>(object.getName().begin);
+
+                if (shapes.find(object.getName().symbol) != shapes.end())
+                {
+                    fail(codegen_name_error, "Object '" + type_name + "' is already declared.");
+                }
+
+                TypeObject* type = heap.create<TypeObject>(type_name, std::move(field_names));
+
+                shapes.emplace(object.getName().symbol, ShapeInfo {std::move(field_symbols), type});
+            }
+
+            for (const IStmt* stmt : unit.getStatements())
+            {
+                dispatch(*stmt);
+            }
+
+            markPureFunctions();
+            emit(encodeABC(op_return, 0, 0, 0));
+            script->setRegisterCount(static_cast<uint8_t>(script_state.max_reg));
+            script->setElidedNilChecks(script_state.elided_nil_checks);
+        }
+        catch (const CodeGenError& error)
+        {
+            state = nullptr;
+
+            return (CodeGenDumpState) {.script = nullptr, .message = error.getMessage(), .error_offset = error.getOffset(), .status = error.getStatus()};
+        }
+
+        state = nullptr;
+
+        return (CodeGenDumpState) {.script = script, .message = {}, .error_offset = 0, .status = codegen_ok};
+    }
+
+    /* Expressions */
+
+    void CodeGen::visitCallExpr(const CallExpr& expr)
+    {
+        uint8_t target = dest;
+        uint8_t base = isTopTemp(target) ? target : allocReg();
+
+        emitCall(expr, base, op_call);
+
+        if (base != target)
+        {
+            emit(encodeABC(op_move, target, base, 0));
+        }
+    }
+
+    void CodeGen::visitElementExpr(const ElementExpr& expr)
+    {
+        uint8_t target = dest;
+        const ElementContent& content = expr.getContent();
+
+        switch (expr.getType())
+        {
+        case fung_simple_type_nil:
+            emit(encodeABC(op_load_nil, target, 0, 0));
+            return;
+        case fung_simple_type_bool:
+            emit(encodeABC(op_load_bool, target, std::get<bool>(content) ? 1 : 0, 0));
+            return;
+        case fung_simple_type_int:
+        {
+            int64_t number = std::get<int64_t>(content);
+
+            if (number < value_int_min || number > value_int_max)
+            {
+                fail(codegen_limit_error, "Integer literal " + std::to_string(number) + " does not fit in a runtime int.");
+            }
+
+            if (number >= std::numeric_limits<int16_t>::min() && number <= std::numeric_limits<int16_t>::max())
+            {
+                emit(encodeAsBx(op_load_int, target, static_cast<int16_t>(number)));
+            }
+            else
+            {
+                emit(encodeABx(op_load_const, target, addConstant(Value::fromInt(number))));
+            }
+
+            return;
+        }
+        case fung_simple_type_float:
+            emit(encodeABx(op_load_const, target, addConstant(Value::fromFloat(std::get<double>(content)))));
+            return;
+        case fung_simple_type_string:
+            current_offset = static_cast<uint32_t>(std::get<Token>(content).begin);
+            emit(encodeABx(op_load_const, target, addName(std::get<Token>(content))));
+            return;
+        case fung_simple_type_list:
+        case fung_simple_type_object:
+        default:
+            break;
+        }
+
+        const auto* object = std::get_if<ObjectLiteral>(&content);
+        ExprRefSpan items = getExprPool().getChildren((object != nullptr) ? object->fields : std::get<ExprRange>(content));
+        uint8_t base = isTopTemp(target) ? target : allocReg();
+
+        if (items.size() > max_registers)
+        {
+            fail(codegen_limit_error, "Too many items in list or object literal.");
+        }
+
+        if (object != nullptr)
+        {
+            emitNameLoad(object->type_name, base);
+        }
+
+        for (ExprRef item : items)
+        {
+            emitExpr(item, allocReg());
+        }
+
+        emit(encodeABC((object != nullptr) ? op_new_object : op_new_list, base, static_cast<uint8_t>(items.size()), 0));
+
+        if (base != target)
+        {
+            emit(encodeABC(op_move, target, base, 0));
+        }
+    }
+
+    void CodeGen::visitAccessExpr(const AccessExpr& expr)
+    {
+        uint8_t target = dest;
+        ExprRefSpan keys = getExprPool().getChildren(expr.getKeys());
+        const auto& lvalue = expr.getLvalueVariant();
+
+        if (keys.size() == 0)
+        {
+            if (const auto* name = std::get_if<Token>(&lvalue); name != nullptr)
+            {
+                emitNameLoad(*name, target);
+            }
+            else
+            {
+                emitExpr(std::get<ExprRef>(lvalue), target);
+            }
+
+            return;
+        }
+
+        uint8_t holder = 0;
+        const ShapeInfo* holder_shape = nullptr;
+
+        if (const auto* name = std::get_if<Token>(&lvalue); name != nullptr)
+        {
+            const Local* local = findLocal(name->symbol);
+
+            holder = (local != nullptr) ? local->reg : allocReg();
+            holder_shape = (local != nullptr) ? local->shape : nullptr;
+
+            if (local == nullptr)
+            {
+                emitNameLoad(*name, holder);
+            }
+        }
+        else
+        {
+            holder = allocReg();
+            emitExpr(std::get<ExprRef>(lvalue), holder);
+        }
+
+        uint8_t key_reg = allocReg();
+        uint8_t chain_reg = (keys.size() > 1) ? allocReg() : key_reg;
+
+        for (uint32_t key_i = 0; key_i < keys.size(); key_i++)
+        {
+            uint8_t result_reg = (key_i + 1 == keys.size()) ? target : chain_reg;
+
+            if (int site = addFieldSite(keys[key_i], holder_shape); site >= 0)
+            {
+                emit(encodeABC(op_get_field, result_reg, holder, static_cast<uint8_t>(site)));
+            }
+            else
+            {
+                emitExpr(keys[key_i], key_reg);
+                emit(encodeABC(op_get_index, result_reg, holder, key_reg));
+            }
+
+            holder = result_reg;
+            holder_shape = nullptr;
+        }
+    }
+
+    void CodeGen::visitUnaryExpr(const UnaryExpr& expr)
+    {
+        uint8_t target = dest;
+
+        if (expr.getOperator() == fung_op_nonil && isNonNil(expr.getInnerExpr()))
+        {
+            state->elided_nil_checks++;
+            emitExpr(expr.getInnerExpr(), target);
+            return;
+        }
+
+        uint8_t inner = emitExprAnywhere(expr.getInnerExpr());
+
+        emit(encodeABC((expr.getOperator() == fung_op_nonil) ? op_nonil : op_neg, target, inner, 0));
+
+        /// @note Past a passed check, the checked local is known to be non-nil until it is next assigned.
+        if (expr.getOperator() != fung_op_nonil || expr.getInnerExpr().getKind() != nested_expr_access)
+        {
+            return;
+        }
+
+        const AccessExpr& access = getExprPool().getAccess(expr.getInnerExpr());
+
+        if (const auto* name = std::get_if<Token>(&access.getLvalueVariant()); name != nullptr && access.getKeys().count == 0)
+        {
+            if (Local* local = findLocal(name->symbol); local != nullptr)
+            {
+                local->non_nil = true;
+            }
+        }
+    }
+
+    void CodeGen::visitBinaryExpr(const BinaryExpr& expr)
+    {
+        uint8_t target = dest;
+        FungOperatorType op = expr.getOperator();
+
+        if (op == fung_op_logic_and || op == fung_op_logic_or)
+        {
+            /// @note A constant left side decides statically whether the right side runs.
+            if (Value lhs {}; tryFold(expr.getLeftExpr(), lhs) && lhs.isBool())
+            {
+                if (lhs.asBool() == (op == fung_op_logic_or))
+                {
+                    emitConstant(lhs, target);
+                }
+                else
+                {
+                    emitExpr(expr.getRightExpr(), target);
+                }
+
+                return;
+            }
+
+            /// @note A local target would be clobbered before the right side could read it.
+            uint8_t result = (target < state->locals_top) ? allocReg() : target;
+
+            emitExpr(expr.getLeftExpr(), result);
+
+            size_t skip_jump = emit(encodeAsBx((op == fung_op_logic_and) ? op_jump_if_not : op_jump_if, result, 0));
+
+            /// @note The right side may not run, so checks passed there prove nothing afterwards.
+            std::vector<uint8_t> facts = saveNilFacts();
+
+            emitExpr(expr.getRightExpr(), result);
+            restoreNilFacts(facts);
+            patchJump(skip_jump);
+
+            if (result != target)
+            {
+                emit(encodeABC(op_move, target, result, 0));
+            }
+
+            return;
+        }
+
+        uint8_t lhs = emitExprAnywhere(expr.getLeftExpr());
+        ExprRef right = expr.getRightExpr();
+
+        /// @note Small constant steps like `n - 1` or `n + STEP` use the immediate form.
+        if (Value folded {}; (op == fung_op_plus || op == fung_op_minus) && tryFold(right, folded) && folded.isInt())
+        {
+            int64_t step = folded.asInt();
+
+            if (op == fung_op_minus)
+            {
+                step = -step;
+            }
+
+            if (step >= std::numeric_limits<int8_t>::min() && step <= std::numeric_limits<int8_t>::max())
+            {
+                emit(encodeABC(op_add_imm, target, lhs, static_cast<uint8_t>(static_cast<int8_t>(step))));
+                return;
+            }
+        }
+
+        uint8_t rhs = emitExprAnywhere(right);
+
+        emit(encodeABC(getBinaryOpcode(op), target, lhs, rhs));
+    }
+
+    /* Statements */
+
+    void CodeGen::visitUseStmt(const UseStmt&)
+    {}
+
+    void CodeGen::visitVarStmt(const VarStmt& stmt)
+    {
+        const Token& name = stmt.getIdentifier();
+        bool is_global = state->function->getName() == script_function_name && state->depth == 0;
+
+        current_offset = static_cast<uint32_t>(name.begin);
+
+        if (!is_global)
+        {
+            uint8_t reg = allocReg();
+
+            emitExpr(stmt.getRXpr(), reg);
+            state->next_reg--;
+
+            bool non_nil = isNonNil(stmt.getRXpr());
+
+            declareLocal(name, !stmt.isImmutable());
+            state->locals.back().non_nil = non_nil;
+
+            if (stmt.isImmutable())
+            {
+                Local& local = state->locals.back();
+
+                local.shape = inferShape(stmt.getRXpr());
+                local.has_constant = tryFold(stmt.getRXpr(), local.constant);
+            }
+
+            return;
+        }
+
+        if (!global_mutability.emplace(name.symbol, !stmt.isImmutable()).second)
+        {
+            fail(codegen_name_error, "Global '" + std::string {getLexeme(name)} + "' is already declared.");
+        }
+
+        /// @note The global is still stored, since other units read it by slot.
+        if (Value folded {}; stmt.isImmutable() && tryFold(stmt.getRXpr(), folded))
+        {
+            global_constants.emplace(name.symbol, folded);
+        }
+
+        if (stmt.isImmutable() && isNonNil(stmt.getRXpr()))
+        {
+            non_nil_globals.insert(name.symbol);
+        }
+
+        uint8_t reg = allocReg();
+
+        emitExpr(stmt.getRXpr(), reg);
+        current_offset = static_cast<uint32_t>(name.begin);
+        emit(encodeABx(op_set_global, reg, resolveGlobal(name)));
+        state->next_reg--;
+    }
+
+    void CodeGen::visitParamDecl(const ParamDecl&)
+    {}
+
+    void CodeGen::visitFuncDecl(const FuncDecl& stmt)
+    {
+        const auto& params = stmt.getParams();
+        std::string name {getLexeme(stmt.getName())};
+
+        current_offset = static_cast<uint32_t>(stmt.getName().begin);
+
+        if (params.size() > max_registers)
+        {
+            fail(codegen_limit_error, "Function " + name + " has too many parameters.");
+        }
+
+        FunctionObject* function = heap.create<FunctionObject>(name, static_cast<uint8_t>(params.size()));
+        FunctionState function_state {{}, function, 0, 0, 0, 0, 1, false, true};
+        FunctionState* outer_state = state;
+
+        state = &function_state;
+
+        /// @note `val` parameters are read-only, while `ref` ones may be reassigned.
+        for (const auto& param : params)
+        {
+            current_offset = static_cast<uint32_t>(param.getIdentifier().begin);
+            declareLocal(param.getIdentifier(), !param.isValue());
+        }
+
+        for (const IStmt* body_stmt : stmt.getBodyBlock().getBody())
+        {
+            dispatch(*body_stmt);
+        }
+
+        emit(encodeABC(op_return, 0, 0, 0));
+        function->setRegisterCount(static_cast<uint8_t>(function_state.max_reg));
+        function->setElidedNilChecks(function_state.elided_nil_checks);
+
+        state = outer_state;
+
+        /// @note Falling off the end returns nil, so every path must reach a `ret`.
+        if (function_state.returned && function_state.returns_non_nil)
+        {
+            non_nil_returns.insert(stmt.getName().symbol);
+        }
+
+        if (std::all_of(params.begin(), params.end(), [](const ParamDecl& param) { return param.isValue(); }))
+        {
+            val_functions.emplace(stmt.getName().symbol, function);
+        }
+
+        global_mutability[stmt.getName().symbol] = false;
+        emitGlobalBinding(stmt.getName(), Value::fromObject(function));
+    }
+
+    void CodeGen::visitFieldDecl(const FieldDecl&)
+    {}
+
+    void CodeGen::visitObjectDecl(const ObjectDecl& stmt)
+    {
+        global_mutability[stmt.getName().symbol] = false;
+        emitGlobalBinding(stmt.getName(), Value::fromObject(shapes.at(stmt.getName().symbol).type));
+    }
+
+    void CodeGen::visitAssignStmt(const AssignStmt& stmt)
+    {
+        const AccessExpr& target = getExprPool().getAccess(stmt.getLValue());
+        ExprRefSpan keys = getExprPool().getChildren(target.getKeys());
+        const auto* name = std::get_if<Token>(&target.getLvalueVariant());
+
+        if (name != nullptr)
+        {
+            current_offset = static_cast<uint32_t>(name->begin);
+        }
+
+        if (keys.size() == 0)
+        {
+            if (Local* local = findLocal(name->symbol); local != nullptr)
+            {
+                if (!local->is_mutable)
+                {
+                    fail(codegen_name_error, "Cannot assign to immutable name '" + std::string {getLexeme(*name)} + "'.");
+                }
+
+                bool non_nil = isNonNil(stmt.getRValue());
+
+                emitExpr(stmt.getRValue(), local->reg);
+                local->non_nil = non_nil;
+                return;
+            }
+
+            if (auto global_it = global_mutability.find(name->symbol); global_it != global_mutability.end() && !global_it->second)
+            {
+                fail(codegen_name_error, "Cannot assign to immutable name '" + std::string {getLexeme(*name)} + "'.");
+            }
+
+            uint8_t reg = allocReg();
+
+            emitExpr(stmt.getRValue(), reg);
+            current_offset = static_cast<uint32_t>(name->begin);
+            emit(encodeABx(op_set_global, reg, resolveGlobal(*name)));
+            state->next_reg--;
+            return;
+        }
+
+        uint16_t saved_next_reg = state->next_reg;
+        uint8_t holder = 0;
+        const ShapeInfo* holder_shape = nullptr;
+
+        if (name != nullptr)
+        {
+            const Local* local = findLocal(name->symbol);
+
+            holder = (local != nullptr) ? local->reg : allocReg();
+            holder_shape = (local != nullptr) ? local->shape : nullptr;
+
+            if (local == nullptr)
+            {
+                emitNameLoad(*name, holder);
+            }
+        }
+        else
+        {
+            holder = allocReg();
+            emitExpr(std::get<ExprRef>(target.getLvalueVariant()), holder);
+        }
+
+        uint8_t key_reg = allocReg();
+
+        for (uint32_t key_i = 0; key_i + 1 < keys.size(); key_i++)
+        {
+            if (int site = addFieldSite(keys[key_i], holder_shape); site >= 0)
+            {
+                emit(encodeABC(op_get_field, key_reg, holder, static_cast<uint8_t>(site)));
+            }
+            else
+            {
+                emitExpr(keys[key_i], key_reg);
+                emit(encodeABC(op_get_index, key_reg, holder, key_reg));
+            }
+
+            holder = key_reg;
+            holder_shape = nullptr;
+            key_reg = allocReg();
+        }
+
+        int last_site = addFieldSite(keys[keys.size() - 1], holder_shape);
+        uint32_t key_offset = current_offset;
+
+        if (last_site < 0)
+        {
+            emitExpr(keys[keys.size() - 1], key_reg);
+        }
+
+        uint8_t value_reg = emitExprAnywhere(stmt.getRValue());
+
+        current_offset = key_offset;
+
+        if (last_site >= 0)
+        {
+            emit(encodeABC(op_set_field, holder, static_cast<uint8_t>(last_site), value_reg));
+        }
+        else
+        {
+            emit(encodeABC(op_set_index, holder, key_reg, value_reg));
+        }
+        state->next_reg = saved_next_reg;
+    }
+
+    void CodeGen::visitReturnStmt(const ReturnStmt& stmt)
+    {
+        state->returns_non_nil = state->returns_non_nil && !stmt.getResult().isNull() && isNonNil(stmt.getResult());
+
+        if (stmt.getResult().isNull())
+        {
+            emit(encodeABC(op_return, 0, 0, 0));
+            state->returned = true;
+            return;
+        }
+
+        state->returned = true;
+
+        uint16_t saved_next_reg = state->next_reg;
+
+        /// @note A returned call reuses this frame, so tail recursion runs in constant stack.
+        if (stmt.getResult().getKind() == nested_expr_call)
+        {
+            emitCall(getExprPool().getCall(stmt.getResult()), allocReg(), op_tail_call);
+            state->next_reg = saved_next_reg;
+            return;
+        }
+
+        uint8_t result = emitExprAnywhere(stmt.getResult());
+
+        emit(encodeABC(op_return, result, 1, 0));
+        state->next_reg = saved_next_reg;
+    }
+
+    void CodeGen::visitIfStmt(const IfStmt& stmt)
+    {
+        /// @note Only the taken branch of a constant condition is generated.
+        if (Value folded {}; tryFold(stmt.getConditional(), folded) && folded.isBool())
+        {
+            if (folded.asBool())
+            {
+                emitBlock(stmt.getBody());
+            }
+            else if (stmt.getOtherElse() != nullptr)
+            {
+                dispatch(*stmt.getOtherElse());
+            }
+
+            return;
+        }
+
+        uint16_t saved_next_reg = state->next_reg;
+        uint8_t condition = emitExprAnywhere(stmt.getConditional());
+        size_t else_jump = emit(encodeAsBx(op_jump_if_not, condition, 0));
+        std::vector<uint8_t> entry_facts = saveNilFacts();
+        bool entry_returned = state->returned;
+
+        state->next_reg = saved_next_reg;
+        emitBlock(stmt.getBody());
+
+        std::vector<uint8_t> then_facts = saveNilFacts();
+        bool then_returned = state->returned;
+        size_t end_jump = 0;
+
+        restoreNilFacts(entry_facts);
+        state->returned = entry_returned;
+
+        if (stmt.getOtherElse() == nullptr)
+        {
+            patchJump(else_jump);
+        }
+        else
+        {
+            end_jump = emit(encodeAsBx(op_jump, 0, 0));
+            patchJump(else_jump);
+            dispatch(*stmt.getOtherElse());
+            patchJump(end_jump);
+        }
+
+        /// @note A branch that always returns never reaches the join, so only the other branch's facts carry on.
+        if (then_returned && !state->returned)
+        {
+            return;
+        }
+
+        if (state->returned && !then_returned)
+        {
+            restoreNilFacts(then_facts);
+            state->returned = entry_returned;
+            return;
+        }
+
+        mergeNilFacts(then_facts);
+    }
+
+    void CodeGen::visitElseStmt(const ElseStmt& stmt)
+    {
+        emitBlock(stmt.getBody());
+    }
+
+    void CodeGen::visitWhileStmt(const WhileStmt& stmt)
+    {
+        if (Value folded {}; tryFold(stmt.getConditional(), folded) && folded.isBool() && !folded.asBool())
+        {
+            return;
+        }
+
+        bool entry_returned = state->returned;
+
+        forgetAssignedNilFacts(stmt.getBody());
+
+        size_t loop_start = getChunk().getCode().size();
+        uint16_t saved_next_reg = state->next_reg;
+        uint8_t condition = emitExprAnywhere(stmt.getConditional());
+        size_t exit_jump = emit(encodeAsBx(op_jump_if_not, condition, 0));
+
+        state->next_reg = saved_next_reg;
+        std::vector<uint8_t> exit_facts = saveNilFacts();
+
+        emitBlock(stmt.getBody());
+        emitJumpBack(loop_start);
+        patchJump(exit_jump);
+
+        /// @note The loop leaves right after its condition, and may never run its body.
+        restoreNilFacts(exit_facts);
+        state->returned = entry_returned;
+    }
+
+    void CodeGen::visitEachStmt(const EachStmt& stmt)
+    {
+        current_offset = static_cast<uint32_t>(stmt.getItemName().begin);
+
+        /// @note The sequence, its length and the index live in hidden locals below the item, so the body cannot clobber them.
+        beginScope();
+
+        uint8_t sequence = allocReg();
+
+        emitExpr(stmt.getSequence(), sequence);
+
+        uint8_t length = allocReg();
+        uint8_t index = allocReg();
+
+        state->locals.push_back({{}, nullptr, Value {}, sequence, state->depth, false, false, false});
+        state->locals.push_back({{}, nullptr, Value {}, length, state->depth, false, false, true});
+        state->locals.push_back({{}, nullptr, Value {}, index, state->depth, false, false, true});
+        state->locals_top = state->next_reg;
+
+        emit(encodeABC(op_len, length, sequence, 0));
+        emit(encodeAsBx(op_load_int, index, 0));
+
+        uint8_t item = declareLocal(stmt.getItemName(), false);
+        uint8_t in_range = allocReg();
+        bool entry_returned = state->returned;
+
+        forgetAssignedNilFacts(stmt.getBody());
+
+        std::vector<uint8_t> exit_facts = saveNilFacts();
+        size_t loop_start = emit(encodeABC(op_lt, in_range, index, length));
+        size_t exit_jump = emit(encodeAsBx(op_jump_if_not, in_range, 0));
+
+        state->next_reg--;
+        emit(encodeABC(op_get_index, item, sequence, index));
+        emitBlock(stmt.getBody());
+        emit(encodeABC(op_add_imm, index, index, 1));
+        emitJumpBack(loop_start);
+        patchJump(exit_jump);
+        restoreNilFacts(exit_facts);
+        state->returned = entry_returned;
+
+        endScope();
+    }
+
+    void CodeGen::visitExprStmt(const ExprStmt& stmt)
+    {
+        uint8_t reg = allocReg();
+
+        emitExpr(stmt.getInner(), reg);
+        state->next_reg--;
+    }
+
+    void CodeGen::visitBlockStmt(const BlockStmt& stmt)
+    {
+        emitBlock(stmt);
+    }
+}
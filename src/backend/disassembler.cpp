@@ -0,0 +1,156 @@
+/**
+ * @file disassembler.cpp
+ * @author DrkWithT
+ * @brief Implements bytecode listing for debugging.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <ostream>
+#include "frontend/symbols.hpp"
+#include "backend/disassembler.hpp"
+#include "backend/natives.hpp"
+
+namespace fung::backend
+{
+    enum OperandLayout
+    {
+        layout_none,
+        layout_a,
+        layout_ab,
+        layout_abc,
+        layout_abi,
+        layout_get_field,
+        layout_set_field,
+        layout_abx,
+        layout_global,
+        layout_asbx,
+        layout_sbx
+    };
+
+    static OperandLayout getOperandLayout(Opcode op)
+    {
+        switch (op)
+        {
+        case op_nop:
+            return layout_none;
+        case op_load_nil:
+            return layout_a;
+        case op_move:
+        case op_load_bool:
+        case op_neg:
+        case op_nonil:
+        case op_new_list:
+        case op_new_object:
+        case op_len:
+        case op_call:
+        case op_tail_call:
+        case op_return:
+            return layout_ab;
+        case op_load_int:
+        case op_jump_if:
+        case op_jump_if_not:
+            return layout_asbx;
+        case op_load_const:
+            return layout_abx;
+        case op_get_global:
+        case op_set_global:
+            return layout_global;
+        case op_jump:
+            return layout_sbx;
+        case op_add_imm:
+            return layout_abi;
+        case op_get_field:
+            return layout_get_field;
+        case op_set_field:
+            return layout_set_field;
+        default:
+            return layout_abc;
+        }
+    }
+
+    void disassemble(const FunctionObject& function, const GlobalTable& globals, std::ostream& out)
+    {
+        const Chunk& chunk = function.getChunk();
+        const auto& constants = chunk.getConstants();
+        const auto& code = chunk.getCode();
+
+        out << "fun " << function.getName() << " (arity " << static_cast<int>(function.getArity()) << ", registers " << static_cast<int>(function.getRegisterCount()) << ")\n";
+
+        for (size_t constant_i = 0; constant_i < constants.size(); constant_i++)
+        {
+            out << "  K" << constant_i << " = " << formatValue(constants[constant_i]) << '\n';
+        }
+
+        for (size_t site_i = 0; site_i < chunk.getFieldSites().size(); site_i++)
+        {
+            const FieldSite& site = chunk.getFieldSites()[site_i];
+
+            out << "  F" << site_i << " = K" << site.key;
+
+            if (site.shape != no_field_shape)
+            {
+                out << " at slot " << site.slot << " of K" << site.shape;
+            }
+
+            out << '\n';
+        }
+
+        for (size_t instr_i = 0; instr_i < code.size(); instr_i++)
+        {
+            Instruction instr = code[instr_i];
+            Opcode op = decodeOp(instr);
+
+            out << "  " << instr_i << ": " << getOpcodeName(op);
+
+            switch (getOperandLayout(op))
+            {
+            case layout_none:
+                break;
+            case layout_a:
+                out << " R" << static_cast<int>(decodeA(instr));
+                break;
+            case layout_ab:
+                out << " R" << static_cast<int>(decodeA(instr)) << ' ' << static_cast<int>(decodeB(instr));
+                break;
+            case layout_abc:
+                out << " R" << static_cast<int>(decodeA(instr)) << " R" << static_cast<int>(decodeB(instr)) << " R" << static_cast<int>(decodeC(instr));
+                break;
+            case layout_abi:
+                out << " R" << static_cast<int>(decodeA(instr)) << " R" << static_cast<int>(decodeB(instr)) << ' ' << static_cast<int>(static_cast<int8_t>(decodeC(instr)));
+                break;
+            case layout_get_field:
+                out << " R" << static_cast<int>(decodeA(instr)) << " R" << static_cast<int>(decodeB(instr)) << " F" << static_cast<int>(decodeC(instr));
+                break;
+            case layout_set_field:
+                out << " R" << static_cast<int>(decodeA(instr)) << " F" << static_cast<int>(decodeB(instr)) << " R" << static_cast<int>(decodeC(instr));
+                break;
+            case layout_abx:
+                out << " R" << static_cast<int>(decodeA(instr)) << " K" << decodeBx(instr);
+                break;
+            case layout_global:
+                out << " R" << static_cast<int>(decodeA(instr)) << " G" << decodeBx(instr) << " (" << fung::frontend::getSymbolText(globals.getSymbol(decodeBx(instr))) << ')';
+                break;
+            case layout_asbx:
+                out << " R" << static_cast<int>(decodeA(instr)) << ' ' << decodeSBx(instr);
+                break;
+            case layout_sbx:
+            default:
+                out << " -> " << static_cast<long>(instr_i) + 1 + decodeSBx(instr);
+                break;
+            }
+
+            out << '\n';
+        }
+
+        for (const auto& constant : constants)
+        {
+            if (const auto* nested = asObjectOf<FunctionObject, object_kind_function>(constant); nested != nullptr)
+            {
+                disassemble(*nested, globals, out);
+            }
+        }
+    }
+}
@@ -0,0 +1,57 @@
+/**
+ * @file globals.cpp
+ * @author DrkWithT
+ * @brief Implements the program-wide global slot table.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "backend/globals.hpp"
+
+namespace fung::backend
+{
+    GlobalTable::GlobalTable()
+    : slots {}, symbols {}, values {}, defined {}
+    {}
+
+    int GlobalTable::resolve(uint32_t symbol)
+    {
+        if (auto slot_it = slots.find(symbol); slot_it != slots.end())
+        {
+            return slot_it->second;
+        }
+
+        if (symbols.size() >= max_globals)
+        {
+            return -1;
+        }
+
+        uint16_t slot = static_cast<uint16_t>(symbols.size());
+
+        slots.emplace(symbol, slot);
+        symbols.push_back(symbol);
+        values.emplace_back();
+        defined.push_back(0);
+
+        return slot;
+    }
+
+    int GlobalTable::find(uint32_t symbol) const
+    {
+        auto slot_it = slots.find(symbol);
+
+        return (slot_it != slots.end()) ? slot_it->second : -1;
+    }
+
+    uint32_t GlobalTable::getSymbol(uint16_t slot) const
+    {
+        return symbols[slot];
+    }
+
+    size_t GlobalTable::getCount() const
+    {
+        return symbols.size();
+    }
+}
@@ -0,0 +1,411 @@
+/**
+ * @file heap.cpp
+ * @author DrkWithT
+ * @brief Implements the runtime object heap and its generational collector.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include "frontend/symbols.hpp"
+#include "backend/heap.hpp"
+
+namespace fung::backend
+{
+    static uint64_t nowMicros()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    Heap::Heap()
+    : objects {}, symbol_strings {}, nursery {}, nursery_objects {}, nursery_capacity {0}, nursery_used {0}, old_objects {}, remembered {}, scan_stack {}, mark_stack {}, old_bytes {0}, old_limit {default_old_limit_bytes}, initial_old_limit {default_old_limit_bytes}, sweep_cursor {0}, sweep_keep {0}, sweep_end {0}, sweep_freed {0}, next_step_at {SIZE_MAX}, pause_budget_us {default_pause_budget_us}, stats {}, phase {gc_phase_idle}, collection_due {false}, minor_due {false}, minor_active {false}
+    {
+        configure({.nursery_bytes = default_nursery_bytes, .old_limit_bytes = default_old_limit_bytes, .pause_budget_us = default_pause_budget_us});
+    }
+
+    Heap::~Heap()
+    {
+        for (HeapObject* object : nursery_objects)
+        {
+            object->~HeapObject();
+        }
+    }
+
+    void Heap::configure(const GcConfig& config)
+    {
+        if (!nursery_objects.empty())
+        {
+            return;
+        }
+
+        nursery_capacity = (config.nursery_bytes + nursery_align - 1) & ~(nursery_align - 1);
+        nursery = std::make_unique<std::max_align_t[]>((nursery_capacity + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t));
+        nursery_used = 0;
+        initial_old_limit = config.old_limit_bytes;
+        old_limit = initial_old_limit;
+        pause_budget_us = config.pause_budget_us;
+    }
+
+    size_t Heap::estimateBytes(const HeapObject& object)
+    {
+        switch (object.getKind())
+        {
+        case object_kind_string:
+            return sizeof(StringObject) + static_cast<const StringObject&>(object).getPayloadBytes();
+        case object_kind_list:
+            return sizeof(ListObject) + static_cast<const ListObject&>(object).getItems().capacity() * sizeof(Value);
+        case object_kind_instance:
+            return sizeof(InstanceObject) + static_cast<const InstanceObject&>(object).getSlots().capacity() * sizeof(Value);
+        default:
+            return sizeof(HeapObject);
+        }
+    }
+
+    void Heap::addOld(std::unique_ptr<HeapObject> object)
+    {
+        /// @note A full nursery sends new objects here directly, and their initial contents may be young, or old and not yet marked.
+        object->space = heap_space_old;
+        object->remembered = true;
+        remembered.push_back(object.get());
+        old_bytes += estimateBytes(*object);
+
+        if (phase == gc_phase_marking)
+        {
+            shade(object.get());
+        }
+
+        old_objects.emplace_back(std::move(object));
+    }
+
+    HeapObject* Heap::promote(HeapObject* object)
+    {
+        if (object->forwarded != nullptr)
+        {
+            return object->forwarded;
+        }
+
+        std::unique_ptr<HeapObject> moved;
+
+        switch (object->getKind())
+        {
+        case object_kind_string:
+            moved = std::make_unique<StringObject>(std::move(*static_cast<StringObject*>(object)));
+            break;
+        case object_kind_list:
+            moved = std::make_unique<ListObject>(std::move(*static_cast<ListObject*>(object)));
+            break;
+        case object_kind_instance:
+        default:
+            moved = std::make_unique<InstanceObject>(std::move(*static_cast<InstanceObject*>(object)));
+            break;
+        }
+
+        size_t moved_bytes = estimateBytes(*moved);
+
+        moved->space = heap_space_old;
+        object->forwarded = moved.get();
+        stats.bytes_promoted += moved_bytes;
+        old_bytes += moved_bytes;
+        scan_stack.push_back(moved.get());
+
+        /// @note Survivors promoted while marking count as reached, since something live referenced them.
+        if (phase == gc_phase_marking)
+        {
+            shade(moved.get());
+        }
+
+        old_objects.emplace_back(std::move(moved));
+
+        return object->forwarded;
+    }
+
+    void Heap::traceChildren(HeapObject& object)
+    {
+        if (object.getKind() == object_kind_string)
+        {
+            if (auto& text = static_cast<StringObject&>(object); text.isRope())
+            {
+                visitValue(text.getRopeLeft());
+                visitValue(text.getRopeRight());
+            }
+        }
+        else if (object.getKind() == object_kind_list)
+        {
+            /// @note Number lists hold no references, so only mixed ones need their items visited.
+            if (static_cast<ListObject&>(object).getElements() != list_elements_mixed)
+            {
+                return;
+            }
+
+            for (Value& item : static_cast<ListObject&>(object).getItems())
+            {
+                visitValue(item);
+            }
+        }
+        else if (object.getKind() == object_kind_instance)
+        {
+            for (Value& slot : static_cast<InstanceObject&>(object).getSlots())
+            {
+                visitValue(slot);
+            }
+        }
+    }
+
+    void Heap::visitValue(Value& value)
+    {
+        if (!value.isObject())
+        {
+            return;
+        }
+
+        HeapObject* object = value.asObject();
+
+        if (minor_active)
+        {
+            if (object->space == heap_space_young)
+            {
+                value = Value::fromObject(promote(object));
+            }
+        }
+        else
+        {
+            shade(object);
+        }
+    }
+
+    void Heap::visitRoot(Value& value)
+    {
+        visitValue(value);
+    }
+
+    void Heap::collectMinor(GcRootSource& roots)
+    {
+        minor_active = true;
+        roots.traceRoots(*this);
+
+        for (HeapObject* holder : remembered)
+        {
+            holder->remembered = false;
+            traceChildren(*holder);
+        }
+
+        remembered.clear();
+
+        while (!scan_stack.empty())
+        {
+            HeapObject* object = scan_stack.back();
+
+            scan_stack.pop_back();
+            traceChildren(*object);
+        }
+
+        minor_active = false;
+
+        for (HeapObject* object : nursery_objects)
+        {
+            object->~HeapObject();
+        }
+
+        nursery_objects.clear();
+        nursery_used = 0;
+        minor_due = false;
+        stats.minor_count++;
+    }
+
+    bool Heap::drainMarks(uint64_t start_us, uint64_t deadline_us)
+    {
+        size_t scanned = 0;
+
+        while (!mark_stack.empty())
+        {
+            HeapObject* object = mark_stack.back();
+
+            mark_stack.pop_back();
+            traceChildren(*object);
+
+            if (deadline_us != 0 && ++scanned % step_check_interval == 0 && nowMicros() - start_us >= deadline_us)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool Heap::sweepOld(uint64_t start_us, uint64_t deadline_us)
+    {
+        while (sweep_cursor < sweep_end)
+        {
+            std::unique_ptr<HeapObject>& object = old_objects[sweep_cursor++];
+
+            if (object->marked)
+            {
+                object->marked = false;
+                old_objects[sweep_keep++] = std::move(object);
+            }
+            else
+            {
+                sweep_freed += estimateBytes(*object);
+                object.reset();
+            }
+
+            if (deadline_us != 0 && sweep_cursor % step_check_interval == 0 && nowMicros() - start_us >= deadline_us)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void Heap::finishSweep()
+    {
+        /// @note Objects promoted during the sweep sit past sweep_end and move down after the survivors.
+        auto tail_begin = old_objects.begin() + static_cast<std::ptrdiff_t>(sweep_end);
+        auto keep_end = std::move(tail_begin, old_objects.end(), old_objects.begin() + static_cast<std::ptrdiff_t>(sweep_keep));
+
+        old_objects.erase(keep_end, old_objects.end());
+        old_bytes -= std::min(old_bytes, sweep_freed);
+        stats.bytes_freed += sweep_freed;
+        stats.major_count++;
+        old_limit = std::max(initial_old_limit, old_bytes * 2);
+        phase = gc_phase_idle;
+    }
+
+    void Heap::stepMajor(GcRootSource& roots, uint64_t start_us, uint64_t deadline_us)
+    {
+        if (phase == gc_phase_marking)
+        {
+            stats.mark_steps++;
+
+            if (!drainMarks(start_us, deadline_us))
+            {
+                return;
+            }
+
+            /// @note Young objects and roots are not covered by the write barrier, so marking ends by promoting the nursery, which shades its survivors, then rescanning the roots. Only then is every live old object known to be marked.
+            if (!nursery_objects.empty())
+            {
+                collectMinor(roots);
+            }
+
+            roots.traceRoots(*this);
+            drainMarks(start_us, 0);
+
+            phase = gc_phase_sweeping;
+            sweep_cursor = 0;
+            sweep_keep = 0;
+            sweep_end = old_objects.size();
+            sweep_freed = 0;
+        }
+
+        /// @note Compacting the tail of old_objects touches every freed slot, so it waits for the next step unless this one has half its budget left or had nothing else to do.
+        bool sweep_was_done = sweep_cursor == sweep_end;
+
+        if (sweepOld(start_us, deadline_us) && (sweep_was_done || deadline_us == 0 || nowMicros() - start_us < deadline_us / 2))
+        {
+            finishSweep();
+        }
+    }
+
+    void Heap::recordPause(uint64_t pause_us)
+    {
+        size_t bucket = 0;
+
+        while (bucket + 1 < gc_pause_bucket_count && pause_us > gc_pause_bucket_limits[bucket])
+        {
+            bucket++;
+        }
+
+        stats.pause_buckets[bucket]++;
+        stats.total_pause_us += pause_us;
+        stats.max_pause_us = std::max(stats.max_pause_us, pause_us);
+    }
+
+    void Heap::collect(GcRootSource& roots)
+    {
+        uint64_t start_us = nowMicros();
+
+        if (minor_due)
+        {
+            collectMinor(roots);
+        }
+
+        if (phase == gc_phase_idle && old_bytes > old_limit)
+        {
+            phase = gc_phase_marking;
+            roots.traceRoots(*this);
+        }
+
+        if (phase != gc_phase_idle)
+        {
+            /// @note Steps stop an eighth short of the budget, leaving room for the time between clock checks. An old generation that outgrows twice its limit mid-collection is finished at once rather than left to grow further.
+            bool unbounded = pause_budget_us == 0 || old_bytes > old_limit * 2;
+
+            stepMajor(roots, start_us, unbounded ? 0 : pause_budget_us - pause_budget_us / 8);
+        }
+
+        collection_due = false;
+        next_step_at = (phase != gc_phase_idle) ? nursery_used + nursery_capacity / 8 : SIZE_MAX;
+
+        recordPause(nowMicros() - start_us);
+    }
+
+    Value Heap::makeString(std::string text)
+    {
+        return Value::fromObject(allocate<StringObject>(std::move(text)));
+    }
+
+    Value Heap::internString(uint32_t symbol)
+    {
+        auto string_it = symbol_strings.find(symbol);
+
+        if (string_it == symbol_strings.end())
+        {
+            std::string_view text = fung::frontend::getSymbolText(symbol);
+
+            /// @note Symbol texts live until exit, so literals and names borrow them instead of copying.
+            string_it = symbol_strings.emplace(symbol, Value::fromObject(create<StringObject>(text.data(), text.size()))).first;
+        }
+
+        return string_it->second;
+    }
+
+    size_t Heap::getObjectCount() const
+    {
+        return objects.size() + old_objects.size() + nursery_objects.size();
+    }
+
+    const GcStats& Heap::getStats() const
+    {
+        return stats;
+    }
+
+    void Heap::reportStats(std::ostream& out) const
+    {
+        out << "gc minor: " << stats.minor_count << ", major: " << stats.major_count << ", mark steps: " << stats.mark_steps << '\n'
+            << "gc pause total: " << stats.total_pause_us << " us, max: " << stats.max_pause_us << " us, budget: " << pause_budget_us << " us\n"
+            << "gc pauses:";
+
+        for (size_t bucket = 0; bucket < gc_pause_bucket_count; bucket++)
+        {
+            if (bucket + 1 < gc_pause_bucket_count)
+            {
+                out << " <=" << gc_pause_bucket_limits[bucket] << "us " << stats.pause_buckets[bucket];
+            }
+            else
+            {
+                out << " >" << gc_pause_bucket_limits[bucket - 1] << "us " << stats.pause_buckets[bucket];
+            }
+        }
+
+        out << '\n'
+            << "gc promoted: " << stats.bytes_promoted << " bytes, freed: " << stats.bytes_freed << " bytes\n"
+            << "gc old generation: " << old_bytes << " of " << old_limit << " bytes, nursery: " << nursery_capacity << " bytes\n";
+    }
+}
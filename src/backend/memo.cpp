@@ -0,0 +1,123 @@
+/**
+ * @file memo.cpp
+ * @author DrkWithT
+ * @brief Implements the LRU result cache for pure functions.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <ostream>
+#include <vector>
+#include "backend/heap.hpp"
+#include "backend/memo.hpp"
+
+namespace fung::backend
+{
+    static bool isMemoizable(const Value& value)
+    {
+        return !value.isObject() || asString(value) != nullptr;
+    }
+
+    MemoTable::MemoTable(size_t max_entries)
+    : entries {}, index {}, stats {}, capacity {(max_entries > 0) ? max_entries : 1}, evictions {0}
+    {}
+
+    bool MemoTable::makeKey(const FunctionObject* function, const Value* args, uint8_t argc, std::string& key)
+    {
+        key.assign(reinterpret_cast<const char*>(&function), sizeof(function));
+
+        for (uint8_t arg_i = 0; arg_i < argc; arg_i++)
+        {
+            const Value& arg = args[arg_i];
+
+            if (!isMemoizable(arg))
+            {
+                return false;
+            }
+
+            /// @note Strings are keyed by text since equal strings may be separate objects, and length-prefixed so adjacent arguments cannot run together.
+            if (const StringObject* text = asString(arg); text != nullptr)
+            {
+                uint32_t length = static_cast<uint32_t>(text->getLength());
+
+                key.push_back('s');
+                key.append(reinterpret_cast<const char*>(&length), sizeof(length));
+                key.append(text->getText());
+                continue;
+            }
+
+            uint64_t bits = arg.getBits();
+
+            key.push_back('v');
+            key.append(reinterpret_cast<const char*>(&bits), sizeof(bits));
+        }
+
+        return true;
+    }
+
+    const Value* MemoTable::find(const FunctionObject* function, const std::string& key)
+    {
+        MemoStats& function_stats = stats[function];
+        auto entry_it = index.find(key);
+
+        if (entry_it == index.end())
+        {
+            function_stats.misses++;
+            return nullptr;
+        }
+
+        function_stats.hits++;
+        entries.splice(entries.begin(), entries, entry_it->second);
+
+        return &entry_it->second->result;
+    }
+
+    void MemoTable::insert(std::string key, const Value& result)
+    {
+        if (!isMemoizable(result) || index.find(key) != index.end())
+        {
+            return;
+        }
+
+        if (entries.size() == capacity)
+        {
+            index.erase(entries.back().key);
+            entries.pop_back();
+            evictions++;
+        }
+
+        entries.push_front({std::move(key), result});
+        index.emplace(entries.front().key, entries.begin());
+    }
+
+    void MemoTable::traceRoots(Heap& heap)
+    {
+        for (Entry& entry : entries)
+        {
+            heap.visitRoot(entry.result);
+        }
+    }
+
+    void MemoTable::report(std::ostream& out) const
+    {
+        uint64_t total_hits = 0;
+        uint64_t total_misses = 0;
+        std::vector<std::pair<const FunctionObject*, MemoStats>> sorted_stats {stats.begin(), stats.end()};
+
+        std::sort(sorted_stats.begin(), sorted_stats.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.first->getName() < rhs.first->getName();
+        });
+
+        for (const auto& [function, function_stats] : sorted_stats)
+        {
+            out << "memo " << function->getName() << ": hits " << function_stats.hits << ", misses " << function_stats.misses << '\n';
+            total_hits += function_stats.hits;
+            total_misses += function_stats.misses;
+        }
+
+        out << "memo total: hits " << total_hits << ", misses " << total_misses << ", entries " << entries.size() << " of " << capacity << ", evictions " << evictions << '\n';
+    }
+}
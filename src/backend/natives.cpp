@@ -0,0 +1,589 @@
+/**
+ * @file natives.cpp
+ * @author DrkWithT
+ * @brief Implements the built-in native modules.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <array>
+#include <charconv>
+#include <iostream>
+#include <type_traits>
+#include "frontend/symbols.hpp"
+#include "backend/heap.hpp"
+#include "backend/natives.hpp"
+#include "backend/runtimeerror.hpp"
+
+namespace fung::backend
+{
+    static std::string formatFloat(double number)
+    {
+        char buffer[32] {};
+        auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), number);
+
+        if (error != std::errc {})
+        {
+            return "?";
+        }
+
+        std::string text(buffer, end);
+
+        /// @note Keep floats visibly distinct from ints, e.g `6.0` rather than `6`.
+        if (text.find_first_of(".en") == std::string::npos)
+        {
+            text.append(".0");
+        }
+
+        return text;
+    }
+
+    std::string formatValue(const Value& value)
+    {
+        switch (value.getType())
+        {
+        case value_type_nil:
+            return "nil";
+        case value_type_bool:
+            return value.asBool() ? "$T" : "$F";
+        case value_type_int:
+            return std::to_string(value.asInt());
+        case value_type_float:
+            return formatFloat(value.asFloat());
+        case value_type_object:
+        default:
+            break;
+        }
+
+        HeapObject* object = value.asObject();
+
+        switch (object->getKind())
+        {
+        case object_kind_string:
+            return std::string {static_cast<const StringObject*>(object)->getText()};
+        case object_kind_list:
+        {
+            std::string text {"["};
+            bool first = true;
+
+            for (const auto& item : static_cast<const ListObject*>(object)->getItems())
+            {
+                if (!first)
+                {
+                    text.append(", ");
+                }
+
+                text.append(formatValue(item));
+                first = false;
+            }
+
+            text.push_back(']');
+
+            return text;
+        }
+        case object_kind_instance:
+            return "<" + static_cast<const InstanceObject*>(object)->getType()->getName() + " object>";
+        case object_kind_type:
+            return "<type " + static_cast<const TypeObject*>(object)->getName() + ">";
+        case object_kind_function:
+            return "<fun " + static_cast<const FunctionObject*>(object)->getName() + ">";
+        case object_kind_native:
+        default:
+            return std::string {"<native "} + static_cast<const NativeObject*>(object)->getName() + ">";
+        }
+    }
+
+    static const StringObject* expectString(const Value& value, const char* native_name)
+    {
+        const StringObject* text = asString(value);
+
+        if (text == nullptr)
+        {
+            throw RuntimeError {vm_status_type_error, std::string {native_name} + "() expects a string but got " + getValueTypeName(value) + "."};
+        }
+
+        return text;
+    }
+
+    /* stdio */
+
+    static Value nativePrint(Heap&, const Value* args, uint8_t)
+    {
+        std::cout << expectString(args[0], "print")->getText() << '\n';
+
+        return Value {};
+    }
+
+    static Value nativePuts(Heap&, const Value* args, uint8_t)
+    {
+        std::cout << expectString(args[0], "puts")->getText() << '\n';
+
+        return Value {};
+    }
+
+    /* stringify */
+
+    static Value nativeToString(Heap& heap, const Value* args, uint8_t)
+    {
+        if (asString(args[0]) != nullptr)
+        {
+            return args[0];
+        }
+
+        return heap.makeString(formatValue(args[0]));
+    }
+
+    /* numeric */
+
+    /// @note Lanes of the reduction kernels below. Each lane folds every fourth item in order, a shape compilers vectorize without needing to reassociate float math.
+    constexpr size_t kernel_lanes = 4;
+
+    static const ListObject* expectList(const Value& value, const char* native_name)
+    {
+        const ListObject* list = asList(value);
+
+        if (list == nullptr)
+        {
+            throw RuntimeError {vm_status_type_error, std::string {native_name} + "() expects a list but got " + getValueTypeName(value) + "."};
+        }
+
+        return list;
+    }
+
+    /// @brief Gives a list's element kind after checking that a mixed list still holds only numbers.
+    static ListElements expectNumbers(const ListObject& list, const char* native_name)
+    {
+        if (list.getElements() != list_elements_mixed)
+        {
+            return list.getElements();
+        }
+
+        const std::vector<Value>& items = list.getItems();
+
+        for (size_t item_i = 0; item_i < items.size(); item_i++)
+        {
+            if (!items[item_i].isNumber())
+            {
+                throw RuntimeError {vm_status_type_error, std::string {native_name} + "() expects a list of numbers but item " + std::to_string(item_i) + " is " + getValueTypeName(items[item_i]) + "."};
+            }
+        }
+
+        return list_elements_mixed;
+    }
+
+    /// @note Mirrors the VM's `+`: ints wrap, and any float makes the result a float.
+    static Value addNumbers(const Value& lhs, const Value& rhs)
+    {
+        if (lhs.isInt() && rhs.isInt())
+        {
+            return Value::fromInt(static_cast<int64_t>(lhs.getIntBits() + rhs.getIntBits()));
+        }
+
+        return Value::fromFloat(lhs.asNumber() + rhs.asNumber());
+    }
+
+    static Value mulNumbers(const Value& lhs, const Value& rhs)
+    {
+        if (lhs.isInt() && rhs.isInt())
+        {
+            return Value::fromInt(static_cast<int64_t>(lhs.getIntBits() * rhs.getIntBits()));
+        }
+
+        return Value::fromFloat(lhs.asNumber() * rhs.asNumber());
+    }
+
+    /// @note Mirrors the VM's `<`, comparing ints exactly and anything else as floats.
+    static bool lessNumber(const Value& lhs, const Value& rhs)
+    {
+        if (lhs.isInt() && rhs.isInt())
+        {
+            return lhs.asInt() < rhs.asInt();
+        }
+
+        return lhs.asNumber() < rhs.asNumber();
+    }
+
+    /// @note Int words add in full and wrap to the int width once at the end, which gives the same result as wrapping after every add.
+    static uint64_t sumIntWords(const Value* items, size_t count)
+    {
+        uint64_t lanes[kernel_lanes] {};
+        size_t item_i = 0;
+
+        for (; item_i + kernel_lanes <= count; item_i += kernel_lanes)
+        {
+            for (size_t lane = 0; lane < kernel_lanes; lane++)
+            {
+                lanes[lane] += items[item_i + lane].getIntBits();
+            }
+        }
+
+        for (; item_i < count; item_i++)
+        {
+            lanes[item_i % kernel_lanes] += items[item_i].getIntBits();
+        }
+
+        return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+
+    static double sumFloats(const Value* items, size_t count)
+    {
+        double lanes[kernel_lanes] {};
+        size_t item_i = 0;
+
+        for (; item_i + kernel_lanes <= count; item_i += kernel_lanes)
+        {
+            for (size_t lane = 0; lane < kernel_lanes; lane++)
+            {
+                lanes[lane] += items[item_i + lane].asFloat();
+            }
+        }
+
+        for (; item_i < count; item_i++)
+        {
+            lanes[item_i % kernel_lanes] += items[item_i].asFloat();
+        }
+
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+
+    /**
+     * @brief Finds the least item of a number list, or the greatest if `greatest` is set, as a script loop comparing with `<` or `>` would.
+     * @note Every lane starts from the first item, so a NaN first item wins as it would in such a loop, and later NaNs never do.
+     */
+    template <bool greatest, typename Number, typename Load>
+    static Number pickNumber(const Value* items, size_t count, Load load)
+    {
+        Number first = load(items[0]);
+        Number lanes[kernel_lanes] {first, first, first, first};
+        size_t item_i = 0;
+
+        for (; item_i + kernel_lanes <= count; item_i += kernel_lanes)
+        {
+            for (size_t lane = 0; lane < kernel_lanes; lane++)
+            {
+                Number item = load(items[item_i + lane]);
+
+                lanes[lane] = (greatest ? lanes[lane] < item : item < lanes[lane]) ? item : lanes[lane];
+            }
+        }
+
+        for (; item_i < count; item_i++)
+        {
+            Number item = load(items[item_i]);
+            Number& lane = lanes[item_i % kernel_lanes];
+
+            lane = (greatest ? lane < item : item < lane) ? item : lane;
+        }
+
+        Number result = lanes[0];
+
+        for (size_t lane = 1; lane < kernel_lanes; lane++)
+        {
+            result = (greatest ? result < lanes[lane] : lanes[lane] < result) ? lanes[lane] : result;
+        }
+
+        return result;
+    }
+
+    template <bool greatest>
+    static Value pickItem(const Value* args, const char* native_name)
+    {
+        const ListObject* list = expectList(args[0], native_name);
+        ListElements elements = expectNumbers(*list, native_name);
+        const std::vector<Value>& items = list->getItems();
+
+        if (items.empty())
+        {
+            throw RuntimeError {vm_status_index_error, std::string {native_name} + "() of an empty list."};
+        }
+
+        switch (elements)
+        {
+        case list_elements_ints:
+            return Value::fromInt(pickNumber<greatest, int64_t>(items.data(), items.size(), [](const Value& item) { return item.asInt(); }));
+        case list_elements_floats:
+            return Value::fromFloat(pickNumber<greatest, double>(items.data(), items.size(), [](const Value& item) { return item.asFloat(); }));
+        case list_elements_mixed:
+        default:
+            break;
+        }
+
+        Value result = items[0];
+
+        for (const Value& item : items)
+        {
+            if (greatest ? lessNumber(result, item) : lessNumber(item, result))
+            {
+                result = item;
+            }
+        }
+
+        return result;
+    }
+
+    static Value nativeSum(Heap&, const Value* args, uint8_t)
+    {
+        const ListObject* list = expectList(args[0], "sum");
+        const std::vector<Value>& items = list->getItems();
+
+        switch (expectNumbers(*list, "sum"))
+        {
+        case list_elements_ints:
+            return Value::fromInt(static_cast<int64_t>(sumIntWords(items.data(), items.size())));
+        case list_elements_floats:
+            return Value::fromFloat(sumFloats(items.data(), items.size()));
+        case list_elements_mixed:
+        default:
+            break;
+        }
+
+        Value total = Value::fromInt(0);
+
+        for (const Value& item : items)
+        {
+            total = addNumbers(total, item);
+        }
+
+        return total;
+    }
+
+    static Value nativeMin(Heap&, const Value* args, uint8_t)
+    {
+        return pickItem<false>(args, "min");
+    }
+
+    static Value nativeMax(Heap&, const Value* args, uint8_t)
+    {
+        return pickItem<true>(args, "max");
+    }
+
+    static Value nativeDot(Heap&, const Value* args, uint8_t)
+    {
+        const ListObject* lhs = expectList(args[0], "dot");
+        const ListObject* rhs = expectList(args[1], "dot");
+        ListElements lhs_elements = expectNumbers(*lhs, "dot");
+        ListElements rhs_elements = expectNumbers(*rhs, "dot");
+        const Value* lhs_items = lhs->getItems().data();
+        const Value* rhs_items = rhs->getItems().data();
+        size_t count = lhs->getItems().size();
+
+        if (count != rhs->getItems().size())
+        {
+            throw RuntimeError {vm_status_index_error, "dot() expects lists of the same length but got " + std::to_string(count) + " and " + std::to_string(rhs->getItems().size()) + " items."};
+        }
+
+        if (lhs_elements == list_elements_ints && rhs_elements == list_elements_ints)
+        {
+            uint64_t lanes[kernel_lanes] {};
+
+            for (size_t item_i = 0; item_i < count; item_i++)
+            {
+                lanes[item_i % kernel_lanes] += lhs_items[item_i].getIntBits() * rhs_items[item_i].getIntBits();
+            }
+
+            return Value::fromInt(static_cast<int64_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]));
+        }
+
+        if (lhs_elements == list_elements_floats && rhs_elements == list_elements_floats)
+        {
+            double lanes[kernel_lanes] {};
+
+            for (size_t item_i = 0; item_i < count; item_i++)
+            {
+                lanes[item_i % kernel_lanes] += lhs_items[item_i].asFloat() * rhs_items[item_i].asFloat();
+            }
+
+            return Value::fromFloat((lanes[0] + lanes[1]) + (lanes[2] + lanes[3]));
+        }
+
+        /// @note A mixed list may still hold only ints, e.g after a store replaced its one nil, so other inputs take the per-item path a script loop would, which stays int until a float turns up.
+        Value total = Value::fromInt(0);
+
+        for (size_t item_i = 0; item_i < count; item_i++)
+        {
+            total = addNumbers(total, mulNumbers(lhs_items[item_i], rhs_items[item_i]));
+        }
+
+        return total;
+    }
+
+    /**
+     * @brief Combines a number list item by item with another list of the same length, or with one number, into a new list.
+     * @note Int lists combine as raw words, which the int fast paths of `combine` keep exact, and float lists as doubles, so neither kernel checks item types.
+     */
+    template <typename Combine>
+    static Value combineItems(Heap& heap, const Value* args, const char* native_name, Combine combine)
+    {
+        const ListObject* lhs = expectList(args[0], native_name);
+        ListElements lhs_elements = expectNumbers(*lhs, native_name);
+        const std::vector<Value>& lhs_items = lhs->getItems();
+        std::vector<Value> results(lhs_items.size());
+
+        if (args[1].isNumber())
+        {
+            const Value scalar = args[1];
+
+            for (size_t item_i = 0; item_i < lhs_items.size(); item_i++)
+            {
+                results[item_i] = combine(lhs_items[item_i], scalar);
+            }
+
+            return Value::fromObject(heap.allocate<ListObject>(std::move(results)));
+        }
+
+        const ListObject* rhs = asList(args[1]);
+
+        if (rhs == nullptr)
+        {
+            throw RuntimeError {vm_status_type_error, std::string {native_name} + "() expects a list or number but got " + getValueTypeName(args[1]) + "."};
+        }
+
+        ListElements rhs_elements = expectNumbers(*rhs, native_name);
+        const std::vector<Value>& rhs_items = rhs->getItems();
+
+        if (lhs_items.size() != rhs_items.size())
+        {
+            throw RuntimeError {vm_status_index_error, std::string {native_name} + "() expects lists of the same length but got " + std::to_string(lhs_items.size()) + " and " + std::to_string(rhs_items.size()) + " items."};
+        }
+
+        if (lhs_elements == list_elements_mixed || lhs_elements != rhs_elements)
+        {
+            for (size_t item_i = 0; item_i < lhs_items.size(); item_i++)
+            {
+                results[item_i] = combine(lhs_items[item_i], rhs_items[item_i]);
+            }
+        }
+        else if (lhs_elements == list_elements_ints)
+        {
+            for (size_t item_i = 0; item_i < lhs_items.size(); item_i++)
+            {
+                results[item_i] = Value::fromInt(static_cast<int64_t>(combine(lhs_items[item_i].getIntBits(), rhs_items[item_i].getIntBits())));
+            }
+        }
+        else
+        {
+            for (size_t item_i = 0; item_i < lhs_items.size(); item_i++)
+            {
+                results[item_i] = Value::fromFloat(combine(lhs_items[item_i].asFloat(), rhs_items[item_i].asFloat()));
+            }
+        }
+
+        return Value::fromObject(heap.allocate<ListObject>(std::move(results)));
+    }
+
+    static Value nativeAdd(Heap& heap, const Value* args, uint8_t)
+    {
+        return combineItems(heap, args, "add", [](const auto& lhs, const auto& rhs) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(lhs)>, Value>)
+            {
+                return addNumbers(lhs, rhs);
+            }
+            else
+            {
+                return lhs + rhs;
+            }
+        });
+    }
+
+    static Value nativeMul(Heap& heap, const Value* args, uint8_t)
+    {
+        return combineItems(heap, args, "mul", [](const auto& lhs, const auto& rhs) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(lhs)>, Value>)
+            {
+                return mulNumbers(lhs, rhs);
+            }
+            else
+            {
+                return lhs * rhs;
+            }
+        });
+    }
+
+    /// @note List literals are capped by the register window, so this is how scripts make long lists for the kernels above.
+    static Value nativeRange(Heap& heap, const Value* args, uint8_t)
+    {
+        if (!args[0].isInt())
+        {
+            throw RuntimeError {vm_status_type_error, std::string {"range() expects an int but got "} + getValueTypeName(args[0]) + "."};
+        }
+
+        if (args[0].asInt() < 0)
+        {
+            throw RuntimeError {vm_status_index_error, "range() expects a count of at least 0 but got " + std::to_string(args[0].asInt()) + "."};
+        }
+
+        std::vector<Value> items(static_cast<size_t>(args[0].asInt()));
+
+        for (size_t item_i = 0; item_i < items.size(); item_i++)
+        {
+            items[item_i] = Value::fromInt(static_cast<int64_t>(item_i));
+        }
+
+        return Value::fromObject(heap.allocate<ListObject>(std::move(items)));
+    }
+
+    static constexpr NativeEntry stdio_entries[] = {
+        {"print", nativePrint, 1},
+        {"puts", nativePuts, 1}
+    };
+
+    static constexpr NativeEntry stringify_entries[] = {
+        {"toString", nativeToString, 1},
+        {"to_str", nativeToString, 1}
+    };
+
+    static constexpr NativeEntry numeric_entries[] = {
+        {"sum", nativeSum, 1},
+        {"min", nativeMin, 1},
+        {"max", nativeMax, 1},
+        {"dot", nativeDot, 2},
+        {"add", nativeAdd, 2},
+        {"mul", nativeMul, 2},
+        {"range", nativeRange, 1}
+    };
+
+    static constexpr NativeModule native_modules[] = {
+        {"stdio", stdio_entries, sizeof(stdio_entries) / sizeof(NativeEntry), true},
+        {"stringify", stringify_entries, sizeof(stringify_entries) / sizeof(NativeEntry), true},
+        {"numeric", numeric_entries, sizeof(numeric_entries) / sizeof(NativeEntry), false}
+    };
+
+    const NativeModule* findNativeModule(uint32_t name_symbol)
+    {
+        constexpr size_t module_count = sizeof(native_modules) / sizeof(NativeModule);
+
+        /// @note Interned once, on the first lookup.
+        static const std::array<uint32_t, module_count> module_symbols = [] {
+            std::array<uint32_t, module_count> symbols {};
+
+            for (size_t module_i = 0; module_i < module_count; module_i++)
+            {
+                symbols[module_i] = fung::frontend::internSymbol(native_modules[module_i].name);
+            }
+
+            return symbols;
+        }();
+
+        for (size_t module_i = 0; module_i < module_count; module_i++)
+        {
+            if (module_symbols[module_i] == name_symbol)
+            {
+                return &native_modules[module_i];
+            }
+        }
+
+        return nullptr;
+    }
+
+    const NativeModule* getNativeModules()
+    {
+        return native_modules;
+    }
+
+    size_t getNativeModuleCount()
+    {
+        return sizeof(native_modules) / sizeof(NativeModule);
+    }
+}
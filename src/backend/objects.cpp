@@ -0,0 +1,306 @@
+/**
+ * @file objects.cpp
+ * @author DrkWithT
+ * @brief Implements heap object types.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <utility>
+#include "backend/objects.hpp"
+
+namespace fung::backend
+{
+    /* StringObject impl. */
+
+    StringObject::StringObject(std::string text_value)
+    : HeapObject {object_kind_string}, text(std::move(text_value)), left {}, right {}, data {nullptr}, length {0}, form {string_form_owned}
+    {
+        data = text.data();
+        length = text.size();
+    }
+
+    StringObject::StringObject(const char* borrowed_data, size_t borrowed_length)
+    : HeapObject {object_kind_string}, text {}, left {}, right {}, data {borrowed_data}, length {borrowed_length}, form {string_form_borrowed}
+    {}
+
+    StringObject::StringObject(const Value& lhs, const Value& rhs)
+    : HeapObject {object_kind_string}, text {}, left {lhs}, right {rhs}, data {nullptr}, length {asString(lhs)->getLength() + asString(rhs)->getLength()}, form {string_form_rope}
+    {}
+
+    /// @note Owned text may sit in std::string's inline buffer, which moves with it, so the data pointer is taken afresh.
+    StringObject::StringObject(StringObject&& other) noexcept
+    : HeapObject {std::move(other)}, text(std::move(other.text)), left {other.left}, right {other.right}, data {other.data}, length {other.length}, form {other.form}
+    {
+        if (form == string_form_owned)
+        {
+            data = text.data();
+        }
+    }
+
+    void StringObject::flatten() const
+    {
+        std::string flat;
+        std::vector<const StringObject*> pending {this};
+
+        flat.reserve(length);
+
+        /// @note Walks the rope with an explicit stack, since `s = s + x` loops build ropes as deep as their iteration count.
+        while (!pending.empty())
+        {
+            const StringObject* part = pending.back();
+
+            pending.pop_back();
+
+            if (part->form == string_form_rope)
+            {
+                pending.push_back(static_cast<const StringObject*>(part->right.asObject()));
+                pending.push_back(static_cast<const StringObject*>(part->left.asObject()));
+                continue;
+            }
+
+            flat.append(part->data, part->length);
+        }
+
+        text = std::move(flat);
+        data = text.data();
+        left = Value {};
+        right = Value {};
+        form = string_form_owned;
+    }
+
+    std::string_view StringObject::getText() const
+    {
+        if (form == string_form_rope)
+        {
+            flatten();
+        }
+
+        return {data, length};
+    }
+
+    size_t StringObject::getLength() const
+    {
+        return length;
+    }
+
+    bool StringObject::isRope() const
+    {
+        return form == string_form_rope;
+    }
+
+    Value& StringObject::getRopeLeft()
+    {
+        return left;
+    }
+
+    Value& StringObject::getRopeRight()
+    {
+        return right;
+    }
+
+    size_t StringObject::getPayloadBytes() const
+    {
+        static const size_t inline_capacity = std::string {}.capacity();
+
+        return (text.capacity() > inline_capacity) ? text.capacity() : 0;
+    }
+
+    /* ListObject impl. */
+
+    static ListElements classifyItems(const std::vector<Value>& items)
+    {
+        bool all_ints = true;
+        bool all_floats = true;
+
+        for (const Value& item : items)
+        {
+            all_ints = all_ints && item.isInt();
+            all_floats = all_floats && item.isFloat();
+        }
+
+        if (all_ints)
+        {
+            return list_elements_ints;
+        }
+
+        return all_floats ? list_elements_floats : list_elements_mixed;
+    }
+
+    ListObject::ListObject(std::vector<Value> item_values)
+    : HeapObject {object_kind_list}, elements {classifyItems(item_values)}, items(std::move(item_values))
+    {}
+
+    std::vector<Value>& ListObject::getItems()
+    {
+        return items;
+    }
+
+    const std::vector<Value>& ListObject::getItems() const
+    {
+        return items;
+    }
+
+    ListElements ListObject::getElements() const
+    {
+        return elements;
+    }
+
+    void ListObject::setItem(size_t index, const Value& value)
+    {
+        if ((elements == list_elements_ints && !value.isInt()) || (elements == list_elements_floats && !value.isFloat()))
+        {
+            elements = list_elements_mixed;
+        }
+
+        items[index] = value;
+    }
+
+    /* TypeObject impl. */
+
+    TypeObject::TypeObject(std::string type_name, std::vector<std::string> fields)
+    : HeapObject {object_kind_type}, slots {}, field_names(std::move(fields)), name(std::move(type_name))
+    {
+        for (size_t field_i = 0; field_i < field_names.size(); field_i++)
+        {
+            slots.emplace(field_names[field_i], static_cast<uint16_t>(field_i));
+        }
+    }
+
+    const std::string& TypeObject::getName() const
+    {
+        return name;
+    }
+
+    const std::vector<std::string>& TypeObject::getFieldNames() const
+    {
+        return field_names;
+    }
+
+    int TypeObject::findSlot(const std::string& field_name) const
+    {
+        auto slot_it = slots.find(field_name);
+
+        if (slot_it == slots.end())
+        {
+            return -1;
+        }
+
+        return slot_it->second;
+    }
+
+    /* InstanceObject impl. */
+
+    InstanceObject::InstanceObject(const TypeObject* type_info, const Value* initial_values, uint8_t initial_count)
+    : HeapObject {object_kind_instance}, slots(type_info->getFieldNames().size()), type {type_info}
+    {
+        std::copy(initial_values, initial_values + initial_count, slots.begin());
+    }
+
+    const TypeObject* InstanceObject::getType() const
+    {
+        return type;
+    }
+
+    std::vector<Value>& InstanceObject::getSlots()
+    {
+        return slots;
+    }
+
+    const std::vector<Value>& InstanceObject::getSlots() const
+    {
+        return slots;
+    }
+
+    Value* InstanceObject::findField(const std::string& field_name)
+    {
+        int slot = type->findSlot(field_name);
+
+        if (slot < 0)
+        {
+            return nullptr;
+        }
+
+        return &slots[slot];
+    }
+
+    /* FunctionObject impl. */
+
+    FunctionObject::FunctionObject(std::string function_name, uint8_t param_count)
+    : HeapObject {object_kind_function}, chunk {}, name(std::move(function_name)), elided_nil_checks {0}, arity {param_count}, register_count {param_count}, pure {false}
+    {}
+
+    Chunk& FunctionObject::getChunk()
+    {
+        return chunk;
+    }
+
+    const Chunk& FunctionObject::getChunk() const
+    {
+        return chunk;
+    }
+
+    const std::string& FunctionObject::getName() const
+    {
+        return name;
+    }
+
+    uint8_t FunctionObject::getArity() const
+    {
+        return arity;
+    }
+
+    uint8_t FunctionObject::getRegisterCount() const
+    {
+        return register_count;
+    }
+
+    void FunctionObject::setRegisterCount(uint8_t count)
+    {
+        register_count = (count > arity) ? count : arity;
+    }
+
+    uint16_t FunctionObject::getElidedNilChecks() const
+    {
+        return elided_nil_checks;
+    }
+
+    void FunctionObject::setElidedNilChecks(uint16_t count)
+    {
+        elided_nil_checks = count;
+    }
+
+    bool FunctionObject::isPure() const
+    {
+        return pure;
+    }
+
+    void FunctionObject::setPure(bool flag)
+    {
+        pure = flag;
+    }
+
+    /* NativeObject impl. */
+
+    NativeObject::NativeObject(NativeFn native_fn, const char* native_name, uint8_t param_count)
+    : HeapObject {object_kind_native}, function {native_fn}, name {native_name}, arity {param_count}
+    {}
+
+    NativeFn NativeObject::getFunction() const
+    {
+        return function;
+    }
+
+    const char* NativeObject::getName() const
+    {
+        return name;
+    }
+
+    uint8_t NativeObject::getArity() const
+    {
+        return arity;
+    }
+}
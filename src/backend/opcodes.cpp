@@ -0,0 +1,61 @@
+/**
+ * @file opcodes.cpp
+ * @author DrkWithT
+ * @brief Implements opcode naming for disassembly and diagnostics.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "backend/opcodes.hpp"
+
+namespace fung::backend
+{
+    static constexpr const char* opcode_names[opcode_count] = {
+        "nop",
+        "move",
+        "load_nil",
+        "load_bool",
+        "load_int",
+        "load_const",
+        "get_global",
+        "set_global",
+        "add",
+        "add_imm",
+        "sub",
+        "mul",
+        "div",
+        "neg",
+        "nonil",
+        "eq",
+        "ne",
+        "lt",
+        "le",
+        "gt",
+        "ge",
+        "jump",
+        "jump_if",
+        "jump_if_not",
+        "new_list",
+        "new_object",
+        "get_index",
+        "set_index",
+        "get_field",
+        "set_field",
+        "len",
+        "call",
+        "tail_call",
+        "return"
+    };
+
+    const char* getOpcodeName(Opcode op)
+    {
+        if (op > op_last)
+        {
+            return "unknown";
+        }
+
+        return opcode_names[op];
+    }
+}
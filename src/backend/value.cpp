@@ -0,0 +1,88 @@
+/**
+ * @file value.cpp
+ * @author DrkWithT
+ * @brief Implements runtime value helpers.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "backend/objects.hpp"
+#include "backend/value.hpp"
+
+namespace fung::backend
+{
+    bool valuesEqual(const Value& lhs, const Value& rhs)
+    {
+        if (lhs.isInt() && rhs.isInt())
+        {
+            return lhs.asInt() == rhs.asInt();
+        }
+
+        if (lhs.isNumber() && rhs.isNumber())
+        {
+            return lhs.asNumber() == rhs.asNumber();
+        }
+
+        if (lhs.getType() != rhs.getType())
+        {
+            return false;
+        }
+
+        switch (lhs.getType())
+        {
+        case value_type_nil:
+            return true;
+        case value_type_bool:
+            return lhs.asBool() == rhs.asBool();
+        case value_type_object:
+        default:
+            break;
+        }
+
+        const StringObject* lhs_string = asString(lhs);
+        const StringObject* rhs_string = asString(rhs);
+
+        if (lhs_string != nullptr && rhs_string != nullptr)
+        {
+            return lhs_string->getText() == rhs_string->getText();
+        }
+
+        return lhs.asObject() == rhs.asObject();
+    }
+
+    const char* getValueTypeName(const Value& value)
+    {
+        switch (value.getType())
+        {
+        case value_type_nil:
+            return "nil";
+        case value_type_bool:
+            return "bool";
+        case value_type_int:
+            return "int";
+        case value_type_float:
+            return "float";
+        case value_type_object:
+        default:
+            break;
+        }
+
+        switch (value.asObject()->getKind())
+        {
+        case object_kind_string:
+            return "string";
+        case object_kind_list:
+            return "list";
+        case object_kind_instance:
+            return "object";
+        case object_kind_type:
+            return "type";
+        case object_kind_function:
+        case object_kind_native:
+        default:
+            return "function";
+        }
+    }
+}
@@ -0,0 +1,959 @@
+/**
+ * @file vm.cpp
+ * @author DrkWithT
+ * @brief Implements the register-based bytecode VM.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include "frontend/symbols.hpp"
+#include "backend/vm.hpp"
+
+#if defined(__GNUC__) && !defined(FUNG_NO_COMPUTED_GOTO)
+#define FUNG_VM_COMPUTED_GOTO 1
+#else
+#define FUNG_VM_COMPUTED_GOTO 0
+#endif
+
+namespace fung::backend
+{
+    [[noreturn]] static void fail(VMStatus status, std::string message)
+    {
+        throw RuntimeError {status, std::move(message)};
+    }
+
+    static const char* getOperatorText(Opcode op)
+    {
+        switch (op)
+        {
+        case op_add:
+        case op_add_imm:
+            return "+";
+        case op_sub:
+            return "-";
+        case op_mul:
+            return "*";
+        case op_div:
+            return "/";
+        case op_lt:
+            return "<";
+        case op_le:
+            return "<=";
+        case op_gt:
+            return ">";
+        case op_ge:
+        default:
+            return ">=";
+        }
+    }
+
+    /// @note Int arithmetic is done on unsigned words so overflow is defined, then Value::fromInt() wraps the result to the inline int width.
+    static int64_t wrapInt(uint64_t result)
+    {
+        return static_cast<int64_t>(result);
+    }
+
+    VM::VM(Heap& runtime_heap, GlobalTable& global_table)
+    : heap {runtime_heap}, globals {global_table}, registers(register_capacity), frames {}, memo {nullptr}, memo_pending {}, memo_key {}
+    {
+        frames.reserve(max_frames);
+    }
+
+    void VM::defineGlobal(const std::string& name, const Value& value)
+    {
+        if (int slot = globals.resolve(fung::frontend::internSymbol(name)); slot >= 0)
+        {
+            globals.set(static_cast<uint16_t>(slot), value);
+        }
+    }
+
+    const Value* VM::findGlobal(const std::string& name) const
+    {
+        int slot = globals.find(fung::frontend::internSymbol(name));
+
+        if (slot < 0 || !globals.isDefined(static_cast<uint16_t>(slot)))
+        {
+            return nullptr;
+        }
+
+        return &globals.get(static_cast<uint16_t>(slot));
+    }
+
+    void VM::loadNativeModule(const NativeModule& module)
+    {
+        for (size_t entry_i = 0; entry_i < module.count; entry_i++)
+        {
+            const NativeEntry& entry = module.entries[entry_i];
+
+            defineGlobal(entry.name, Value::fromObject(heap.create<NativeObject>(entry.function, entry.name, entry.arity)));
+        }
+    }
+
+    void VM::loadPrelude()
+    {
+        const NativeModule* modules = getNativeModules();
+
+        for (size_t module_i = 0; module_i < getNativeModuleCount(); module_i++)
+        {
+            if (modules[module_i].in_prelude)
+            {
+                loadNativeModule(modules[module_i]);
+            }
+        }
+    }
+
+    void VM::setMemoTable(MemoTable* table)
+    {
+        memo = table;
+    }
+
+    const Value* VM::beginMemoCall(const FunctionObject* function, const Value* args, uint8_t argc, size_t depth)
+    {
+        if (!MemoTable::makeKey(function, args, argc, memo_key))
+        {
+            return nullptr;
+        }
+
+        if (const Value* cached = memo->find(function, memo_key); cached != nullptr)
+        {
+            return cached;
+        }
+
+        /// @note A tail call reuses a frame that may already wait on a result, which then also answers the original call.
+        if (memo_pending.empty() || memo_pending.back().depth != depth)
+        {
+            memo_pending.push_back({memo_key, depth});
+        }
+
+        return nullptr;
+    }
+
+    void VM::finishMemoCall(const Value& result)
+    {
+        if (memo_pending.empty() || memo_pending.back().depth != frames.size())
+        {
+            return;
+        }
+
+        memo->insert(std::move(memo_pending.back().key), result);
+        memo_pending.pop_back();
+    }
+
+    Value VM::concatStrings(const Value& lhs, const StringObject& lhs_text, const Value& rhs, const StringObject& rhs_text)
+    {
+        /// @note Strings are immutable, so joining with an empty one can give back the other as is.
+        if (rhs_text.getLength() == 0)
+        {
+            return lhs;
+        }
+
+        if (lhs_text.getLength() == 0)
+        {
+            return rhs;
+        }
+
+        size_t length = lhs_text.getLength() + rhs_text.getLength();
+
+        if (length < StringObject::min_rope_length)
+        {
+            std::string flat;
+
+            flat.reserve(length);
+            flat.append(lhs_text.getText());
+            flat.append(rhs_text.getText());
+
+            return heap.makeString(std::move(flat));
+        }
+
+        return Value::fromObject(heap.allocate<StringObject>(lhs, rhs));
+    }
+
+    Value VM::arithmeticSlow(Opcode op, const Value& lhs, const Value& rhs)
+    {
+        if (op == op_add)
+        {
+            const StringObject* lhs_text = asString(lhs);
+            const StringObject* rhs_text = asString(rhs);
+
+            if (lhs_text != nullptr && rhs_text != nullptr)
+            {
+                return concatStrings(lhs, *lhs_text, rhs, *rhs_text);
+            }
+        }
+
+        if (!lhs.isNumber() || !rhs.isNumber())
+        {
+            fail(vm_status_type_error, std::string {"Cannot apply '"} + getOperatorText(op) + "' to " + getValueTypeName(lhs) + " and " + getValueTypeName(rhs) + ".");
+        }
+
+        if (lhs.isInt() && rhs.isInt())
+        {
+            int64_t left = lhs.asInt();
+            int64_t right = rhs.asInt();
+
+            switch (op)
+            {
+            case op_add:
+            case op_add_imm:
+                return Value::fromInt(wrapInt(static_cast<uint64_t>(left) + static_cast<uint64_t>(right)));
+            case op_sub:
+                return Value::fromInt(wrapInt(static_cast<uint64_t>(left) - static_cast<uint64_t>(right)));
+            case op_mul:
+                return Value::fromInt(wrapInt(static_cast<uint64_t>(left) * static_cast<uint64_t>(right)));
+            case op_div:
+            default:
+                if (right == 0)
+                {
+                    fail(vm_status_math_error, "Integer division by zero.");
+                }
+
+                if (right == -1)
+                {
+                    return Value::fromInt(wrapInt(0 - static_cast<uint64_t>(left)));
+                }
+
+                return Value::fromInt(left / right);
+            }
+        }
+
+        double left = lhs.asNumber();
+        double right = rhs.asNumber();
+
+        switch (op)
+        {
+        case op_add:
+        case op_add_imm:
+            return Value::fromFloat(left + right);
+        case op_sub:
+            return Value::fromFloat(left - right);
+        case op_mul:
+            return Value::fromFloat(left * right);
+        case op_div:
+        default:
+            return Value::fromFloat(left / right);
+        }
+    }
+
+    bool VM::compareSlow(Opcode op, const Value& lhs, const Value& rhs)
+    {
+        int order = 0;
+
+        if (lhs.isInt() && rhs.isInt())
+        {
+            order = (lhs.asInt() > rhs.asInt()) - (lhs.asInt() < rhs.asInt());
+        }
+        else if (lhs.isNumber() && rhs.isNumber())
+        {
+            order = (lhs.asNumber() > rhs.asNumber()) - (lhs.asNumber() < rhs.asNumber());
+        }
+        else if (asString(lhs) != nullptr && asString(rhs) != nullptr)
+        {
+            int text_order = asString(lhs)->getText().compare(asString(rhs)->getText());
+
+            order = (text_order > 0) - (text_order < 0);
+        }
+        else
+        {
+            fail(vm_status_type_error, std::string {"Cannot compare "} + getValueTypeName(lhs) + " and " + getValueTypeName(rhs) + " with '" + getOperatorText(op) + "'.");
+        }
+
+        switch (op)
+        {
+        case op_lt:
+            return order < 0;
+        case op_le:
+            return order <= 0;
+        case op_gt:
+            return order > 0;
+        case op_ge:
+        default:
+            return order >= 0;
+        }
+    }
+
+    Value VM::getIndex(const Value& target, const Value& key)
+    {
+        if (ListObject* list = asList(target); list != nullptr)
+        {
+            if (!key.isInt())
+            {
+                fail(vm_status_type_error, std::string {"List index must be int, not "} + getValueTypeName(key) + ".");
+            }
+
+            if (key.asInt() < 0 || static_cast<uint64_t>(key.asInt()) >= list->getItems().size())
+            {
+                fail(vm_status_index_error, "List index " + std::to_string(key.asInt()) + " is out of bounds.");
+            }
+
+            return list->getItems()[key.asInt()];
+        }
+
+        /// @note Strings index by byte, as op_len counts them, so `each` also walks a string one character at a time.
+        if (const StringObject* text = asString(target); text != nullptr)
+        {
+            if (!key.isInt())
+            {
+                fail(vm_status_type_error, std::string {"String index must be int, not "} + getValueTypeName(key) + ".");
+            }
+
+            if (key.asInt() < 0 || static_cast<uint64_t>(key.asInt()) >= text->getLength())
+            {
+                fail(vm_status_index_error, "String index " + std::to_string(key.asInt()) + " is out of bounds.");
+            }
+
+            return heap.makeString(std::string(1, text->getText()[key.asInt()]));
+        }
+
+        auto* instance = asObjectOf<InstanceObject, object_kind_instance>(target);
+
+        if (instance == nullptr)
+        {
+            fail(vm_status_type_error, std::string {"Cannot index a "} + getValueTypeName(target) + " value.");
+        }
+
+        const StringObject* field_name = asString(key);
+
+        if (field_name == nullptr)
+        {
+            fail(vm_status_type_error, std::string {"Object field key must be string, not "} + getValueTypeName(key) + ".");
+        }
+
+        const Value* field = instance->findField(std::string {field_name->getText()});
+
+        if (field == nullptr)
+        {
+            fail(vm_status_name_error, "Object of type " + instance->getType()->getName() + " has no field '" + std::string {field_name->getText()} + "'.");
+        }
+
+        return *field;
+    }
+
+    void VM::setIndex(const Value& target, const Value& key, const Value& value)
+    {
+        if (ListObject* list = asList(target); list != nullptr)
+        {
+            if (!key.isInt())
+            {
+                fail(vm_status_type_error, std::string {"List index must be int, not "} + getValueTypeName(key) + ".");
+            }
+
+            if (key.asInt() < 0 || static_cast<uint64_t>(key.asInt()) >= list->getItems().size())
+            {
+                fail(vm_status_index_error, "List index " + std::to_string(key.asInt()) + " is out of bounds.");
+            }
+
+            list->setItem(static_cast<size_t>(key.asInt()), value);
+            heap.writeBarrier(list, value);
+            return;
+        }
+
+        auto* instance = asObjectOf<InstanceObject, object_kind_instance>(target);
+
+        if (instance == nullptr)
+        {
+            fail(vm_status_type_error, std::string {"Cannot index a "} + getValueTypeName(target) + " value.");
+        }
+
+        const StringObject* field_name = asString(key);
+
+        if (field_name == nullptr)
+        {
+            fail(vm_status_type_error, std::string {"Object field key must be string, not "} + getValueTypeName(key) + ".");
+        }
+
+        Value* field = instance->findField(std::string {field_name->getText()});
+
+        if (field == nullptr)
+        {
+            fail(vm_status_name_error, "Object of type " + instance->getType()->getName() + " has no field '" + std::string {field_name->getText()} + "'.");
+        }
+
+        *field = value;
+        heap.writeBarrier(instance, value);
+    }
+
+    Value* VM::findCachedSlot(const Value& target, const FieldSite& site, FieldCache& cache, const Value* consts)
+    {
+        auto* instance = asObjectOf<InstanceObject, object_kind_instance>(target);
+
+        if (instance == nullptr)
+        {
+            cache.misses++;
+            return nullptr;
+        }
+
+        const TypeObject* shape = instance->getType();
+
+        for (uint8_t entry_i = 0; entry_i < cache.count; entry_i++)
+        {
+            if (cache.shapes[entry_i] == shape)
+            {
+                cache.hits++;
+                return &instance->getSlots()[cache.slots[entry_i]];
+            }
+        }
+
+        cache.misses++;
+
+        int slot = shape->findSlot(std::string {static_cast<const StringObject*>(consts[site.key].asObject())->getText()});
+
+        if (slot < 0)
+        {
+            return nullptr;
+        }
+
+        if (cache.count < field_cache_ways)
+        {
+            cache.shapes[cache.count] = shape;
+            cache.slots[cache.count] = static_cast<uint16_t>(slot);
+            cache.count++;
+        }
+
+        return &instance->getSlots()[slot];
+    }
+
+    Value VM::makeInstance(const Value& type, const Value* initial_values, uint8_t initial_count)
+    {
+        const auto* type_info = asObjectOf<TypeObject, object_kind_type>(type);
+
+        if (type_info == nullptr)
+        {
+            fail(vm_status_type_error, std::string {"Cannot construct an object from a "} + getValueTypeName(type) + " value.");
+        }
+
+        if (initial_count > type_info->getFieldNames().size())
+        {
+            fail(vm_status_arity_error, "Too many field values for object of type " + type_info->getName() + ".");
+        }
+
+        return Value::fromObject(heap.allocate<InstanceObject>(type_info, initial_values, initial_count));
+    }
+
+    Value VM::execute()
+    {
+        CallFrame* frame = &frames.back();
+        const Instruction* ip = frame->ip;
+        Value* regs = frame->base;
+        const Value* consts = frame->function->getChunk().getConstants().data();
+        const FieldSite* sites = frame->function->getChunk().getFieldSites().data();
+        FieldCache* caches = frame->function->getChunk().getFieldCaches().data();
+        Instruction instr = 0;
+
+#if FUNG_VM_COMPUTED_GOTO
+        static void* const dispatch_table[opcode_count] = {
+            &&label_op_nop,
+            &&label_op_move,
+            &&label_op_load_nil,
+            &&label_op_load_bool,
+            &&label_op_load_int,
+            &&label_op_load_const,
+            &&label_op_get_global,
+            &&label_op_set_global,
+            &&label_op_add,
+            &&label_op_add_imm,
+            &&label_op_sub,
+            &&label_op_mul,
+            &&label_op_div,
+            &&label_op_neg,
+            &&label_op_nonil,
+            &&label_op_eq,
+            &&label_op_ne,
+            &&label_op_lt,
+            &&label_op_le,
+            &&label_op_gt,
+            &&label_op_ge,
+            &&label_op_jump,
+            &&label_op_jump_if,
+            &&label_op_jump_if_not,
+            &&label_op_new_list,
+            &&label_op_new_object,
+            &&label_op_get_index,
+            &&label_op_set_index,
+            &&label_op_get_field,
+            &&label_op_set_field,
+            &&label_op_len,
+            &&label_op_call,
+            &&label_op_tail_call,
+            &&label_op_return
+        };
+
+#define VM_CASE(op) label_##op
+#define VM_NEXT() do { instr = *ip++; goto *dispatch_table[decodeOp(instr)]; } while (false)
+#else
+#define VM_CASE(op) case op
+#define VM_NEXT() continue
+#endif
+
+/// @note Reloads the cached frame state after a call or return switches frames.
+#define VM_LOAD_FRAME() \
+    do { \
+        frame = &frames.back(); \
+        ip = frame->ip; \
+        regs = frame->base; \
+        consts = frame->function->getChunk().getConstants().data(); \
+        sites = frame->function->getChunk().getFieldSites().data(); \
+        caches = frame->function->getChunk().getFieldCaches().data(); \
+    } while (false)
+
+/// @note Collecting only rewrites register contents, never the register file's address, so cached frame state stays valid.
+#define VM_SAFEPOINT() \
+    do { \
+        if (heap.isCollectionDue()) \
+        { \
+            heap.collect(*this); \
+        } \
+    } while (false)
+
+#define VM_ARITHMETIC(op, int_expr) \
+    do { \
+        const Value& lhs = regs[decodeB(instr)]; \
+        const Value& rhs = regs[decodeC(instr)]; \
+        if (Value::areInts(lhs, rhs)) \
+        { \
+            uint64_t left = lhs.getIntBits(); \
+            uint64_t right = rhs.getIntBits(); \
+            regs[decodeA(instr)] = Value::fromInt(wrapInt(int_expr)); \
+        } \
+        else \
+        { \
+            regs[decodeA(instr)] = arithmeticSlow(op, lhs, rhs); \
+        } \
+    } while (false)
+
+#define VM_COMPARE(op, cmp) \
+    do { \
+        const Value& lhs = regs[decodeB(instr)]; \
+        const Value& rhs = regs[decodeC(instr)]; \
+        bool flag = Value::areInts(lhs, rhs) ? (lhs.asInt() cmp rhs.asInt()) : compareSlow(op, lhs, rhs); \
+        regs[decodeA(instr)] = Value::fromBool(flag); \
+    } while (false)
+
+        try
+        {
+#if FUNG_VM_COMPUTED_GOTO
+            VM_NEXT();
+#else
+            for (;;)
+            {
+                instr = *ip++;
+
+                switch (decodeOp(instr))
+                {
+#endif
+                VM_CASE(op_nop):
+                    VM_NEXT();
+                VM_CASE(op_move):
+                    regs[decodeA(instr)] = regs[decodeB(instr)];
+                    VM_NEXT();
+                VM_CASE(op_load_nil):
+                    regs[decodeA(instr)] = Value {};
+                    VM_NEXT();
+                VM_CASE(op_load_bool):
+                    regs[decodeA(instr)] = Value::fromBool(decodeB(instr) != 0);
+                    VM_NEXT();
+                VM_CASE(op_load_int):
+                    regs[decodeA(instr)] = Value::fromInt(decodeSBx(instr));
+                    VM_NEXT();
+                VM_CASE(op_load_const):
+                    regs[decodeA(instr)] = consts[decodeBx(instr)];
+                    VM_NEXT();
+                VM_CASE(op_get_global):
+                {
+                    uint16_t slot = decodeBx(instr);
+
+                    if (!globals.isDefined(slot))
+                    {
+                        fail(vm_status_name_error, "Undefined name '" + std::string {fung::frontend::getSymbolText(globals.getSymbol(slot))} + "'.");
+                    }
+
+                    regs[decodeA(instr)] = globals.get(slot);
+                    VM_NEXT();
+                }
+                VM_CASE(op_set_global):
+                {
+                    globals.set(decodeBx(instr), regs[decodeA(instr)]);
+                    VM_NEXT();
+                }
+                VM_CASE(op_add):
+                    VM_ARITHMETIC(op_add, left + right);
+                    VM_NEXT();
+                VM_CASE(op_add_imm):
+                {
+                    const Value& lhs = regs[decodeB(instr)];
+                    int64_t imm = static_cast<int8_t>(decodeC(instr));
+
+                    if (lhs.isInt())
+                    {
+                        regs[decodeA(instr)] = Value::fromInt(wrapInt(lhs.getIntBits() + static_cast<uint64_t>(imm)));
+                    }
+                    else
+                    {
+                        regs[decodeA(instr)] = arithmeticSlow(op_add_imm, lhs, Value::fromInt(imm));
+                    }
+
+                    VM_NEXT();
+                }
+                VM_CASE(op_sub):
+                    VM_ARITHMETIC(op_sub, left - right);
+                    VM_NEXT();
+                VM_CASE(op_mul):
+                    VM_ARITHMETIC(op_mul, left * right);
+                    VM_NEXT();
+                VM_CASE(op_div):
+                    regs[decodeA(instr)] = arithmeticSlow(op_div, regs[decodeB(instr)], regs[decodeC(instr)]);
+                    VM_NEXT();
+                VM_CASE(op_neg):
+                {
+                    const Value& inner = regs[decodeB(instr)];
+
+                    if (inner.isInt())
+                    {
+                        regs[decodeA(instr)] = Value::fromInt(wrapInt(0 - inner.getIntBits()));
+                    }
+                    else if (inner.isFloat())
+                    {
+                        regs[decodeA(instr)] = Value::fromFloat(-inner.asFloat());
+                    }
+                    else
+                    {
+                        fail(vm_status_type_error, std::string {"Cannot negate a "} + getValueTypeName(inner) + " value.");
+                    }
+
+                    VM_NEXT();
+                }
+                VM_CASE(op_nonil):
+                    if (regs[decodeB(instr)].isNil())
+                    {
+                        fail(vm_status_nil_error, "Nil check failed.");
+                    }
+
+                    regs[decodeA(instr)] = regs[decodeB(instr)];
+                    VM_NEXT();
+                VM_CASE(op_eq):
+                    regs[decodeA(instr)] = Value::fromBool(valuesEqual(regs[decodeB(instr)], regs[decodeC(instr)]));
+                    VM_NEXT();
+                VM_CASE(op_ne):
+                    regs[decodeA(instr)] = Value::fromBool(!valuesEqual(regs[decodeB(instr)], regs[decodeC(instr)]));
+                    VM_NEXT();
+                VM_CASE(op_lt):
+                    VM_COMPARE(op_lt, <);
+                    VM_NEXT();
+                VM_CASE(op_le):
+                    VM_COMPARE(op_le, <=);
+                    VM_NEXT();
+                VM_CASE(op_gt):
+                    VM_COMPARE(op_gt, >);
+                    VM_NEXT();
+                VM_CASE(op_ge):
+                    VM_COMPARE(op_ge, >=);
+                    VM_NEXT();
+                VM_CASE(op_jump):
+                    if (decodeSBx(instr) < 0)
+                    {
+                        VM_SAFEPOINT();
+                    }
+
+                    ip += decodeSBx(instr);
+                    VM_NEXT();
+                VM_CASE(op_jump_if):
+                VM_CASE(op_jump_if_not):
+                {
+                    const Value& condition = regs[decodeA(instr)];
+
+                    if (!condition.isBool())
+                    {
+                        fail(vm_status_type_error, std::string {"Condition must be bool, not "} + getValueTypeName(condition) + ".");
+                    }
+
+                    if (condition.asBool() == (decodeOp(instr) == op_jump_if))
+                    {
+                        ip += decodeSBx(instr);
+                    }
+
+                    VM_NEXT();
+                }
+                VM_CASE(op_new_list):
+                {
+                    Value* first = regs + decodeA(instr) + 1;
+
+                    regs[decodeA(instr)] = Value::fromObject(heap.allocate<ListObject>(std::vector<Value>(first, first + decodeB(instr))));
+                    VM_NEXT();
+                }
+                VM_CASE(op_new_object):
+                    regs[decodeA(instr)] = makeInstance(regs[decodeA(instr)], regs + decodeA(instr) + 1, decodeB(instr));
+                    VM_NEXT();
+                VM_CASE(op_get_index):
+                    regs[decodeA(instr)] = getIndex(regs[decodeB(instr)], regs[decodeC(instr)]);
+                    VM_NEXT();
+                VM_CASE(op_set_index):
+                    setIndex(regs[decodeA(instr)], regs[decodeB(instr)], regs[decodeC(instr)]);
+                    VM_NEXT();
+                VM_CASE(op_get_field):
+                {
+                    const FieldSite& site = sites[decodeC(instr)];
+                    const Value& target = regs[decodeB(instr)];
+
+                    if (Value* slot = findCachedSlot(target, site, caches[decodeC(instr)], consts); slot != nullptr)
+                    {
+                        regs[decodeA(instr)] = *slot;
+                    }
+                    else
+                    {
+                        regs[decodeA(instr)] = getIndex(target, consts[site.key]);
+                    }
+
+                    VM_NEXT();
+                }
+                VM_CASE(op_set_field):
+                {
+                    const FieldSite& site = sites[decodeB(instr)];
+                    const Value& target = regs[decodeA(instr)];
+
+                    if (Value* slot = findCachedSlot(target, site, caches[decodeB(instr)], consts); slot != nullptr)
+                    {
+                        *slot = regs[decodeC(instr)];
+                        heap.writeBarrier(target.asObject(), *slot);
+                    }
+                    else
+                    {
+                        setIndex(target, consts[site.key], regs[decodeC(instr)]);
+                    }
+
+                    VM_NEXT();
+                }
+                VM_CASE(op_len):
+                {
+                    const Value& target = regs[decodeB(instr)];
+
+                    if (const ListObject* list = asList(target); list != nullptr)
+                    {
+                        regs[decodeA(instr)] = Value::fromInt(static_cast<int64_t>(list->getItems().size()));
+                    }
+                    else if (const StringObject* text = asString(target); text != nullptr)
+                    {
+                        regs[decodeA(instr)] = Value::fromInt(static_cast<int64_t>(text->getLength()));
+                    }
+                    else
+                    {
+                        fail(vm_status_type_error, std::string {"Cannot iterate over a "} + getValueTypeName(target) + " value.");
+                    }
+
+                    VM_NEXT();
+                }
+                VM_CASE(op_call):
+                {
+                    VM_SAFEPOINT();
+
+                    uint8_t callee_reg = decodeA(instr);
+                    uint8_t argc = decodeB(instr);
+                    const Value& callee = regs[callee_reg];
+
+                    if (const auto* function = asObjectOf<FunctionObject, object_kind_function>(callee); function != nullptr)
+                    {
+                        if (argc != function->getArity())
+                        {
+                            fail(vm_status_arity_error, "Function " + function->getName() + " expects " + std::to_string(function->getArity()) + " arguments but got " + std::to_string(argc) + ".");
+                        }
+
+                        Value* callee_base = regs + callee_reg + 1;
+
+                        if (frames.size() == max_frames || callee_base + function->getRegisterCount() > registers.data() + registers.size())
+                        {
+                            fail(vm_status_stack_overflow, "Call stack overflow in " + function->getName() + ".");
+                        }
+
+                        if (memo != nullptr && function->isPure())
+                        {
+                            if (const Value* cached = beginMemoCall(function, callee_base, argc, frames.size() + 1); cached != nullptr)
+                            {
+                                regs[callee_reg] = *cached;
+                                VM_NEXT();
+                            }
+                        }
+
+                        std::fill(callee_base + argc, callee_base + function->getRegisterCount(), Value {});
+
+                        frame->ip = ip;
+                        frames.push_back({function, function->getChunk().getCode().data(), callee_base});
+                        VM_LOAD_FRAME();
+                        VM_NEXT();
+                    }
+
+                    if (const auto* native = asObjectOf<NativeObject, object_kind_native>(callee); native != nullptr)
+                    {
+                        if (argc != native->getArity())
+                        {
+                            fail(vm_status_arity_error, std::string {"Native "} + native->getName() + " expects " + std::to_string(native->getArity()) + " arguments but got " + std::to_string(argc) + ".");
+                        }
+
+                        regs[callee_reg] = native->getFunction()(heap, regs + callee_reg + 1, argc);
+                        VM_NEXT();
+                    }
+
+                    fail(vm_status_type_error, std::string {"Cannot call a "} + getValueTypeName(callee) + " value.");
+                }
+                VM_CASE(op_tail_call):
+                {
+                    VM_SAFEPOINT();
+
+                    uint8_t callee_reg = decodeA(instr);
+                    uint8_t argc = decodeB(instr);
+                    const Value& callee = regs[callee_reg];
+
+                    Value result {};
+                    const Value* cached = nullptr;
+
+                    /// @note The callee takes over this frame: its arguments slide down to the frame base and its result goes where this frame's would have.
+                    if (const auto* function = asObjectOf<FunctionObject, object_kind_function>(callee); function != nullptr)
+                    {
+                        if (argc != function->getArity())
+                        {
+                            fail(vm_status_arity_error, "Function " + function->getName() + " expects " + std::to_string(function->getArity()) + " arguments but got " + std::to_string(argc) + ".");
+                        }
+
+                        if (regs + function->getRegisterCount() > registers.data() + registers.size())
+                        {
+                            fail(vm_status_stack_overflow, "Call stack overflow in " + function->getName() + ".");
+                        }
+
+                        if (memo != nullptr && function->isPure())
+                        {
+                            cached = beginMemoCall(function, regs + callee_reg + 1, argc, frames.size());
+                        }
+
+                        if (cached != nullptr)
+                        {
+                            result = *cached;
+                            goto tail_call_return;
+                        }
+
+                        std::copy(regs + callee_reg + 1, regs + callee_reg + 1 + argc, regs);
+                        std::fill(regs + argc, regs + function->getRegisterCount(), Value {});
+
+                        frame->function = function;
+                        frame->ip = function->getChunk().getCode().data();
+                        VM_LOAD_FRAME();
+                        VM_NEXT();
+                    }
+
+                    if (const auto* native = asObjectOf<NativeObject, object_kind_native>(callee); native != nullptr)
+                    {
+                        if (argc != native->getArity())
+                        {
+                            fail(vm_status_arity_error, std::string {"Native "} + native->getName() + " expects " + std::to_string(native->getArity()) + " arguments but got " + std::to_string(argc) + ".");
+                        }
+
+                        result = native->getFunction()(heap, regs + callee_reg + 1, argc);
+                    }
+                    else
+                    {
+                        fail(vm_status_type_error, std::string {"Cannot call a "} + getValueTypeName(callee) + " value.");
+                    }
+
+                tail_call_return:
+                    if (memo != nullptr)
+                    {
+                        finishMemoCall(result);
+                    }
+
+                    frames.pop_back();
+
+                    if (frames.empty())
+                    {
+                        return result;
+                    }
+
+                    regs[-1] = result;
+                    VM_LOAD_FRAME();
+                    VM_NEXT();
+                }
+                VM_CASE(op_return):
+                {
+                    Value result = (decodeB(instr) != 0) ? regs[decodeA(instr)] : Value {};
+
+                    if (memo != nullptr)
+                    {
+                        finishMemoCall(result);
+                    }
+
+                    frames.pop_back();
+
+                    if (frames.empty())
+                    {
+                        return result;
+                    }
+
+                    regs[-1] = result;
+                    VM_LOAD_FRAME();
+                    VM_NEXT();
+                }
+#if !FUNG_VM_COMPUTED_GOTO
+                }
+            }
+#endif
+        }
+        catch (const RuntimeError&)
+        {
+            frame->ip = ip;
+            throw;
+        }
+
+#undef VM_COMPARE
+#undef VM_ARITHMETIC
+#undef VM_SAFEPOINT
+#undef VM_LOAD_FRAME
+#undef VM_NEXT
+#undef VM_CASE
+    }
+
+    void VM::traceRoots(Heap& heap)
+    {
+        Value* top = registers.data();
+
+        for (const CallFrame& call_frame : frames)
+        {
+            top = std::max(top, call_frame.base + call_frame.function->getRegisterCount());
+        }
+
+        for (Value* reg = registers.data(); reg != top; reg++)
+        {
+            heap.visitRoot(*reg);
+        }
+
+        for (Value& value : globals.getValues())
+        {
+            heap.visitRoot(value);
+        }
+
+        if (memo != nullptr)
+        {
+            memo->traceRoots(heap);
+        }
+    }
+
+    VMResult VM::run(const FunctionObject* script)
+    {
+        frames.clear();
+        memo_pending.clear();
+        std::fill(registers.begin(), registers.begin() + script->getRegisterCount(), Value {});
+        frames.push_back({script, script->getChunk().getCode().data(), registers.data()});
+
+        try
+        {
+            return (VMResult) {.value = execute(), .message = {}, .function = nullptr, .source_offset = 0, .status = vm_status_ok};
+        }
+        catch (const RuntimeError& error)
+        {
+            CallFrame failed_frame = frames.back();
+            const Chunk& failed_chunk = failed_frame.function->getChunk();
+            size_t instr_index = static_cast<size_t>(failed_frame.ip - failed_chunk.getCode().data()) - 1;
+
+            frames.clear();
+
+            return (VMResult) {.value = {}, .message = error.getMessage(), .function = failed_frame.function, .source_offset = failed_chunk.getOffsets()[instr_index], .status = error.getStatus()};
+        }
+    }
+}
@@ -0,0 +1,223 @@
+/**
+ * @file compilation.cpp
+ * @author DrkWithT
+ * @brief Implements concurrent loading and parsing of compilation units.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <filesystem>
+#include <ostream>
+#include <utility>
+#include "frontend/symbols.hpp"
+#include "backend/chunkcache.hpp"
+#include "driver/compilation.hpp"
+
+namespace fung::driver
+{
+    static constexpr const char* script_extension = ".fung";
+
+    static std::string normalizePath(const std::string& path)
+    {
+        std::error_code path_error {};
+        std::filesystem::path canonical_path = std::filesystem::weakly_canonical(path, path_error);
+
+        if (path_error)
+        {
+            return std::filesystem::path {path}.lexically_normal().string();
+        }
+
+        return canonical_path.string();
+    }
+
+    std::pair<size_t, size_t> locateOffset(std::string_view source, size_t offset)
+    {
+        size_t line = 1;
+        size_t column = 1;
+        size_t end = std::min(offset, source.size());
+
+        for (size_t char_i = 0; char_i < end; char_i++)
+        {
+            if (source[char_i] == '\n')
+            {
+                line++;
+                column = 1;
+            }
+            else
+            {
+                column++;
+            }
+        }
+
+        return {line, column};
+    }
+
+    Compilation::Compilation(WorkerPool& worker_pool, bool try_cache)
+    : results {}, scheduled_units {}, results_lock {}, root_count {0}, pool {worker_pool}, use_cache {try_cache}
+    {}
+
+    void Compilation::schedule(const std::string& path, size_t root_order)
+    {
+        std::string normal_path = normalizePath(path);
+        UnitResult* result_ptr = nullptr;
+
+        {
+            std::lock_guard<std::mutex> results_guard {results_lock};
+
+            if (auto scheduled_it = scheduled_units.find(normal_path); scheduled_it != scheduled_units.end())
+            {
+                scheduled_it->second->root_order = std::min(scheduled_it->second->root_order, root_order);
+                return;
+            }
+
+            results.emplace_back(std::make_unique<UnitResult>());
+            result_ptr = results.back().get();
+            result_ptr->path = normal_path;
+            result_ptr->root_order = root_order;
+            scheduled_units.emplace(normal_path, result_ptr);
+        }
+
+        result_ptr->parse_state = {{}, fung::frontend::fung_parse_generic_error, "Not parsed."};
+        result_ptr->cache_body_offset = 0;
+        result_ptr->source_hash = 0;
+        result_ptr->loaded = false;
+
+        pool.submit([this, result_ptr]() {
+            processUnit(*result_ptr);
+        });
+    }
+
+    void Compilation::processUnit(UnitResult& result)
+    {
+        fung::frontend::SourceFile source_file {};
+
+        if (!source_file.load(result.path.c_str()))
+        {
+            result.parse_state.message = "Failed to read file.";
+            return;
+        }
+
+        result.loaded = true;
+        result.unit = std::make_unique<fung::frontend::ProgramUnit>(std::filesystem::path {result.path}.stem().string(), std::move(source_file));
+
+        std::string_view source = result.unit->getSource();
+
+        if (use_cache)
+        {
+            result.source_hash = fung::backend::hashSource(source);
+
+            if (fung::backend::readCacheFile(fung::backend::getCachePath(result.path), result.cache_bytes)
+                && fung::backend::readCacheHeader(result.cache_bytes, result.source_hash, result.module_symbols, result.cache_body_offset) == fung::backend::cache_ok)
+            {
+                result.parse_state = {{}, fung::frontend::fung_parse_ok, ""};
+            }
+            else
+            {
+                result.cache_bytes.clear();
+                result.module_symbols.clear();
+            }
+        }
+
+        if (result.cache_bytes.empty())
+        {
+            fung::frontend::Parser parser {source};
+
+            result.parse_state = parser.parseFile(*result.unit);
+
+            for (const auto& stmt : result.unit->getStatements())
+            {
+                if (stmt->getKind() != fung::syntax::nested_stmt_use)
+                {
+                    continue;
+                }
+
+                const auto* use_stmt = static_cast<const fung::syntax::UseStmt*>(stmt);
+
+                result.module_symbols.push_back(use_stmt->getIdentifier().symbol);
+            }
+        }
+
+        std::filesystem::path unit_dir = std::filesystem::path {result.path}.parent_path();
+
+        for (uint32_t module_symbol : result.module_symbols)
+        {
+            std::filesystem::path module_path = unit_dir / (std::string {fung::frontend::getSymbolText(module_symbol)} + script_extension);
+            std::error_code exists_error {};
+
+            if (!std::filesystem::is_regular_file(module_path, exists_error))
+            {
+                result.module_paths.emplace_back();
+                continue;
+            }
+
+            result.module_paths.push_back(normalizePath(module_path.string()));
+            schedule(module_path.string(), unit_order_discovered);
+        }
+    }
+
+    void Compilation::addRoot(const std::string& path)
+    {
+        size_t root_order = 0;
+
+        {
+            std::lock_guard<std::mutex> results_guard {results_lock};
+            root_order = root_count++;
+        }
+
+        schedule(path, root_order);
+    }
+
+    void Compilation::run()
+    {
+        pool.waitIdle();
+
+        std::sort(results.begin(), results.end(), [](const std::unique_ptr<UnitResult>& lhs, const std::unique_ptr<UnitResult>& rhs) {
+            if (lhs->root_order != rhs->root_order)
+            {
+                return lhs->root_order < rhs->root_order;
+            }
+
+            return lhs->path < rhs->path;
+        });
+    }
+
+    const std::vector<std::unique_ptr<UnitResult>>& Compilation::getResults() const
+    {
+        return results;
+    }
+
+    bool Compilation::isCaching() const
+    {
+        return use_cache;
+    }
+
+    size_t Compilation::reportErrors(std::ostream& out) const
+    {
+        size_t error_count = 0;
+
+        for (const auto& result : results)
+        {
+            if (result->parse_state.status == fung::frontend::fung_parse_ok)
+            {
+                continue;
+            }
+
+            error_count++;
+
+            if (!result->loaded)
+            {
+                out << result->path << ": " << result->parse_state.message << '\n';
+                continue;
+            }
+
+            auto [line, column] = locateOffset(result->unit->getSource(), result->parse_state.error_token.begin);
+
+            out << result->path << ':' << line << ':' << column << ": " << result->parse_state.message << '\n';
+        }
+
+        return error_count;
+    }
+}
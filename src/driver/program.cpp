@@ -0,0 +1,381 @@
+/**
+ * @file program.cpp
+ * @author DrkWithT
+ * @brief Implements building and running a compiled program.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <ostream>
+#include "frontend/symbols.hpp"
+#include "backend/chunkcache.hpp"
+#include "backend/codegen.hpp"
+#include "backend/disassembler.hpp"
+#include "driver/program.hpp"
+
+namespace fung::driver
+{
+    Program::Program(const Compilation& finished_compilation)
+    : heap {}, globals {}, memo {}, vm {heap, globals}, unit_indices {}, function_units {}, scripts {}, unit_states {}, compilation {finished_compilation}
+    {
+        vm.loadPrelude();
+    }
+
+    void Program::indexFunctions(const fung::backend::FunctionObject& function, size_t unit_index)
+    {
+        function_units[&function] = unit_index;
+
+        for (const auto& constant : function.getChunk().getConstants())
+        {
+            if (const auto* nested = fung::backend::asObjectOf<fung::backend::FunctionObject, fung::backend::object_kind_function>(constant); nested != nullptr)
+            {
+                indexFunctions(*nested, unit_index);
+            }
+        }
+    }
+
+    void Program::reportAt(std::ostream& out, size_t unit_index, size_t offset, const std::string& message) const
+    {
+        const UnitResult& result = *compilation.getResults()[unit_index];
+        auto [line, column] = locateOffset(result.unit->getSource(), offset);
+
+        out << result.path << ':' << line << ':' << column << ": " << message << '\n';
+    }
+
+    void Program::reportFieldCaches(const fung::backend::FunctionObject& function, size_t unit_index, std::ostream& out) const
+    {
+        const fung::backend::Chunk& chunk = function.getChunk();
+        const auto& code = chunk.getCode();
+        const auto& caches = chunk.getFieldCaches();
+
+        for (size_t instr_i = 0; instr_i < code.size(); instr_i++)
+        {
+            fung::backend::Opcode op = fung::backend::decodeOp(code[instr_i]);
+
+            if (op != fung::backend::op_get_field && op != fung::backend::op_set_field)
+            {
+                continue;
+            }
+
+            size_t site_i = (op == fung::backend::op_get_field) ? fung::backend::decodeC(code[instr_i]) : fung::backend::decodeB(code[instr_i]);
+            const fung::backend::FieldCache& cache = caches[site_i];
+
+            if (cache.hits + cache.misses == 0)
+            {
+                continue;
+            }
+
+            const auto* key = static_cast<const fung::backend::StringObject*>(chunk.getConstants()[chunk.getFieldSites()[site_i].key].asObject());
+
+            reportAt(out, unit_index, chunk.getOffsets()[instr_i], function.getName() + " [\"" + std::string {key->getText()} + "\"] hits " + std::to_string(cache.hits) + ", misses " + std::to_string(cache.misses) + ", shapes " + std::to_string(cache.count));
+        }
+
+        for (const auto& constant : chunk.getConstants())
+        {
+            if (const auto* nested = fung::backend::asObjectOf<fung::backend::FunctionObject, fung::backend::object_kind_function>(constant); nested != nullptr)
+            {
+                reportFieldCaches(*nested, unit_index, out);
+            }
+        }
+    }
+
+    void Program::reportNilChecks(const fung::backend::FunctionObject& function, const std::string& path, std::ostream& out) const
+    {
+        const fung::backend::Chunk& chunk = function.getChunk();
+        size_t kept_count = 0;
+
+        for (fung::backend::Instruction instr : chunk.getCode())
+        {
+            if (fung::backend::decodeOp(instr) == fung::backend::op_nonil)
+            {
+                kept_count++;
+            }
+        }
+
+        if (kept_count + function.getElidedNilChecks() > 0)
+        {
+            out << path << ": " << function.getName() << " elided " << function.getElidedNilChecks() << " of " << kept_count + function.getElidedNilChecks() << " nil checks\n";
+        }
+
+        for (const auto& constant : chunk.getConstants())
+        {
+            if (const auto* nested = fung::backend::asObjectOf<fung::backend::FunctionObject, fung::backend::object_kind_function>(constant); nested != nullptr)
+            {
+                reportNilChecks(*nested, path, out);
+            }
+        }
+    }
+
+    void Program::markAssignedGlobals(const fung::backend::FunctionObject& function, std::vector<uint8_t>& bound) const
+    {
+        const fung::backend::Chunk& chunk = function.getChunk();
+
+        for (fung::backend::Instruction instr : chunk.getCode())
+        {
+            if (fung::backend::decodeOp(instr) == fung::backend::op_set_global)
+            {
+                bound[fung::backend::decodeBx(instr)] = 1;
+            }
+        }
+
+        for (const auto& constant : chunk.getConstants())
+        {
+            if (const auto* nested = fung::backend::asObjectOf<fung::backend::FunctionObject, fung::backend::object_kind_function>(constant); nested != nullptr)
+            {
+                markAssignedGlobals(*nested, bound);
+            }
+        }
+    }
+
+    size_t Program::reportUnresolvedGlobals(const fung::backend::FunctionObject& function, size_t unit_index, const std::vector<uint8_t>& bound, std::ostream& err) const
+    {
+        const fung::backend::Chunk& chunk = function.getChunk();
+        const auto& code = chunk.getCode();
+        size_t report_count = 0;
+
+        for (size_t instr_i = 0; instr_i < code.size(); instr_i++)
+        {
+            if (fung::backend::decodeOp(code[instr_i]) != fung::backend::op_get_global || bound[fung::backend::decodeBx(code[instr_i])] != 0)
+            {
+                continue;
+            }
+
+            reportAt(err, unit_index, chunk.getOffsets()[instr_i], "Undefined name '" + std::string {fung::frontend::getSymbolText(globals.getSymbol(fung::backend::decodeBx(code[instr_i])))} + "'.");
+            report_count++;
+        }
+
+        for (const auto& constant : chunk.getConstants())
+        {
+            if (const auto* nested = fung::backend::asObjectOf<fung::backend::FunctionObject, fung::backend::object_kind_function>(constant); nested != nullptr)
+            {
+                report_count += reportUnresolvedGlobals(*nested, unit_index, bound, err);
+            }
+        }
+
+        return report_count;
+    }
+
+    size_t Program::build(const ProgramOptions& options, std::ostream& out, std::ostream& err)
+    {
+        const auto& results = compilation.getResults();
+        size_t error_count = 0;
+
+        scripts.assign(results.size(), nullptr);
+        heap.configure(options.gc_config);
+
+        if (options.memo_capacity > 0)
+        {
+            memo = std::make_unique<fung::backend::MemoTable>(options.memo_capacity);
+            vm.setMemoTable(memo.get());
+        }
+        unit_states.assign(results.size(), unit_state_pending);
+
+        for (size_t unit_i = 0; unit_i < results.size(); unit_i++)
+        {
+            unit_indices[results[unit_i]->path] = unit_i;
+        }
+
+        for (size_t unit_i = 0; unit_i < results.size(); unit_i++)
+        {
+            const UnitResult& result = *results[unit_i];
+
+            for (size_t module_i = 0; module_i < result.module_symbols.size(); module_i++)
+            {
+                if (result.module_paths[module_i].empty() && fung::backend::findNativeModule(result.module_symbols[module_i]) == nullptr)
+                {
+                    err << result.path << ": unknown module '" << fung::frontend::getSymbolText(result.module_symbols[module_i]) << "'\n";
+                    error_count++;
+                }
+            }
+
+            if (!result.cache_bytes.empty())
+            {
+                scripts[unit_i] = fung::backend::deserializeUnit(heap, globals, result.cache_bytes, result.cache_body_offset);
+            }
+
+            /// @note A cache that passed the header checks but fails verification is ignored, so the unit is parsed here after all.
+            if (scripts[unit_i] == nullptr && !result.cache_bytes.empty())
+            {
+                fung::frontend::Parser parser {result.unit->getSource()};
+                fung::frontend::ParserDumpState parse_state = parser.parseFile(*result.unit);
+
+                if (parse_state.status != fung::frontend::fung_parse_ok)
+                {
+                    reportAt(err, unit_i, parse_state.error_token.begin, parse_state.message);
+                    error_count++;
+                    continue;
+                }
+            }
+
+            if (scripts[unit_i] == nullptr)
+            {
+                fung::backend::CodeGen generator {heap, globals, *result.unit};
+                fung::backend::CodeGenDumpState generated = generator.generate(*result.unit);
+
+                if (generated.status != fung::backend::codegen_ok)
+                {
+                    reportAt(err, unit_i, generated.error_offset, generated.message);
+                    error_count++;
+                    continue;
+                }
+
+                scripts[unit_i] = generated.script;
+
+                if (options.write_cache)
+                {
+                    fung::backend::writeCacheFile(fung::backend::getCachePath(result.path), fung::backend::serializeUnit(*generated.script, globals, result.module_symbols, result.source_hash));
+                }
+            }
+
+            indexFunctions(*scripts[unit_i], unit_i);
+
+            if (options.show_disassembly)
+            {
+                out << "== " << result.path << '\n';
+                fung::backend::disassemble(*scripts[unit_i], globals, out);
+            }
+        }
+
+        /// @note Globals are shared by all units, so a name counts as bound if any unit assigns it or any loaded native module defines it, however the units end up ordered at runtime.
+        std::vector<uint8_t> bound(globals.getCount(), 0);
+
+        for (size_t slot = 0; slot < globals.getCount(); slot++)
+        {
+            bound[slot] = globals.isDefined(static_cast<uint16_t>(slot)) ? 1 : 0;
+        }
+
+        for (size_t unit_i = 0; unit_i < results.size(); unit_i++)
+        {
+            const UnitResult& result = *results[unit_i];
+
+            for (size_t module_i = 0; module_i < result.module_symbols.size(); module_i++)
+            {
+                const fung::backend::NativeModule* native_module = result.module_paths[module_i].empty() ? fung::backend::findNativeModule(result.module_symbols[module_i]) : nullptr;
+
+                if (native_module == nullptr)
+                {
+                    continue;
+                }
+
+                for (size_t entry_i = 0; entry_i < native_module->count; entry_i++)
+                {
+                    if (int slot = globals.find(fung::frontend::internSymbol(native_module->entries[entry_i].name)); slot >= 0)
+                    {
+                        bound[slot] = 1;
+                    }
+                }
+            }
+
+            if (scripts[unit_i] != nullptr)
+            {
+                markAssignedGlobals(*scripts[unit_i], bound);
+            }
+        }
+
+        for (size_t unit_i = 0; unit_i < results.size(); unit_i++)
+        {
+            if (scripts[unit_i] != nullptr)
+            {
+                error_count += reportUnresolvedGlobals(*scripts[unit_i], unit_i, bound, err);
+            }
+        }
+
+        return error_count;
+    }
+
+    bool Program::runUnit(size_t unit_index, std::ostream& err)
+    {
+        if (unit_states[unit_index] != unit_state_pending)
+        {
+            return true;
+        }
+
+        unit_states[unit_index] = unit_state_started;
+
+        const UnitResult& result = *compilation.getResults()[unit_index];
+
+        for (size_t module_i = 0; module_i < result.module_symbols.size(); module_i++)
+        {
+            if (result.module_paths[module_i].empty())
+            {
+                vm.loadNativeModule(*fung::backend::findNativeModule(result.module_symbols[module_i]));
+                continue;
+            }
+
+            if (!runUnit(unit_indices.at(result.module_paths[module_i]), err))
+            {
+                return false;
+            }
+        }
+
+        fung::backend::VMResult outcome = vm.run(scripts[unit_index]);
+
+        if (outcome.status == fung::backend::vm_status_ok)
+        {
+            return true;
+        }
+
+        reportAt(err, function_units.at(outcome.function), outcome.source_offset, "runtime error in " + outcome.function->getName() + ": " + outcome.message);
+
+        return false;
+    }
+
+    bool Program::run(std::ostream& err)
+    {
+        const auto& results = compilation.getResults();
+
+        for (size_t unit_i = 0; unit_i < results.size(); unit_i++)
+        {
+            if (results[unit_i]->root_order == unit_order_discovered)
+            {
+                continue;
+            }
+
+            if (!runUnit(unit_i, err))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void Program::reportFieldCaches(std::ostream& out) const
+    {
+        for (size_t unit_i = 0; unit_i < scripts.size(); unit_i++)
+        {
+            if (scripts[unit_i] != nullptr)
+            {
+                reportFieldCaches(*scripts[unit_i], unit_i, out);
+            }
+        }
+    }
+
+    void Program::reportMemo(std::ostream& out) const
+    {
+        if (memo != nullptr)
+        {
+            memo->report(out);
+        }
+    }
+
+    void Program::reportGc(std::ostream& out) const
+    {
+        heap.reportStats(out);
+    }
+
+    void Program::reportNilChecks(std::ostream& out) const
+    {
+        const auto& results = compilation.getResults();
+
+        for (size_t unit_i = 0; unit_i < scripts.size(); unit_i++)
+        {
+            if (scripts[unit_i] != nullptr)
+            {
+                reportNilChecks(*scripts[unit_i], results[unit_i]->path, out);
+            }
+        }
+    }
+}
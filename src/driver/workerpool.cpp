@@ -0,0 +1,189 @@
+/**
+ * @file workerpool.cpp
+ * @author DrkWithT
+ * @brief Implements the work-stealing thread pool.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <utility>
+#include "driver/workerpool.hpp"
+
+namespace fung::driver
+{
+    /// @note Lets submit() find the calling worker's own deque.
+    static thread_local const WorkerPool* current_pool = nullptr;
+    static thread_local size_t current_worker_id = 0;
+
+    WorkerPool::WorkerPool(size_t worker_count)
+    : queues {}, workers {}, state_lock {}, work_ready {}, work_done {}, pending_count {0}, submit_epoch {0}, next_queue {0}, stopping {false}
+    {
+        if (worker_count == 0)
+        {
+            worker_count = std::thread::hardware_concurrency();
+        }
+
+        if (worker_count == 0)
+        {
+            worker_count = 1;
+        }
+
+        for (size_t queue_i = 0; queue_i < worker_count; queue_i++)
+        {
+            queues.emplace_back(std::make_unique<WorkerQueue>());
+        }
+
+        for (size_t worker_i = 0; worker_i < worker_count; worker_i++)
+        {
+            workers.emplace_back(&WorkerPool::runWorker, this, worker_i);
+        }
+    }
+
+    WorkerPool::~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> state_guard {state_lock};
+            stopping = true;
+        }
+
+        work_ready.notify_all();
+
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    bool WorkerPool::popOwn(size_t worker_id, WorkerTask& task)
+    {
+        WorkerQueue& queue = *queues[worker_id];
+        std::lock_guard<std::mutex> queue_guard {queue.lock};
+
+        if (queue.tasks.empty())
+        {
+            return false;
+        }
+
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+
+        return true;
+    }
+
+    bool WorkerPool::stealOther(size_t worker_id, WorkerTask& task)
+    {
+        size_t queue_count = queues.size();
+
+        for (size_t offset = 1; offset < queue_count; offset++)
+        {
+            WorkerQueue& victim = *queues[(worker_id + offset) % queue_count];
+            std::lock_guard<std::mutex> victim_guard {victim.lock};
+
+            if (!victim.tasks.empty())
+            {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void WorkerPool::runWorker(size_t worker_id)
+    {
+        current_pool = this;
+        current_worker_id = worker_id;
+
+        WorkerTask task {};
+
+        while (true)
+        {
+            size_t seen_epoch = 0;
+
+            {
+                std::lock_guard<std::mutex> state_guard {state_lock};
+                seen_epoch = submit_epoch;
+            }
+
+            if (popOwn(worker_id, task) || stealOther(worker_id, task))
+            {
+                task();
+                task = nullptr;
+
+                std::lock_guard<std::mutex> state_guard {state_lock};
+
+                if (--pending_count == 0)
+                {
+                    work_done.notify_all();
+                    work_ready.notify_all();
+                }
+
+                continue;
+            }
+
+            std::unique_lock<std::mutex> state_guard {state_lock};
+
+            /// @note Any submit after the epoch was read may have missed this worker's scan, so only sleep while the epoch is unchanged.
+            work_ready.wait(state_guard, [this, seen_epoch]() {
+                return submit_epoch != seen_epoch || (stopping && pending_count == 0);
+            });
+
+            if (stopping && pending_count == 0)
+            {
+                return;
+            }
+        }
+    }
+
+    void WorkerPool::submit(WorkerTask task)
+    {
+        size_t queue_id = 0;
+
+        if (current_pool == this)
+        {
+            queue_id = current_worker_id;
+        }
+        else
+        {
+            std::lock_guard<std::mutex> state_guard {state_lock};
+            queue_id = next_queue;
+            next_queue = (next_queue + 1) % queues.size();
+        }
+
+        {
+            std::lock_guard<std::mutex> state_guard {state_lock};
+            pending_count++;
+        }
+
+        {
+            WorkerQueue& queue = *queues[queue_id];
+            std::lock_guard<std::mutex> queue_guard {queue.lock};
+            queue.tasks.emplace_back(std::move(task));
+        }
+
+        {
+            std::lock_guard<std::mutex> state_guard {state_lock};
+            submit_epoch++;
+        }
+
+        work_ready.notify_all();
+    }
+
+    void WorkerPool::waitIdle()
+    {
+        std::unique_lock<std::mutex> state_guard {state_lock};
+
+        work_done.wait(state_guard, [this]() {
+            return pending_count == 0;
+        });
+    }
+
+    size_t WorkerPool::getWorkerCount() const
+    {
+        return workers.size();
+    }
+}
@@ -9,119 +9,226 @@
  */
 
 #include "frontend/lexer.hpp"
+#include "frontend/symbols.hpp"
 
 namespace fung::frontend
 {
     /* Tokenizer constants and helpers */
-    static constexpr char test_sp = ' ';
-    static constexpr char test_tb = '\t';
-    static constexpr char test_cr = '\r';
-    static constexpr char test_lf = '\n';
-    static const char* test_operator_symbols = "?+-*/=!<>&|";
-    
-    static constexpr size_t test_keyword_count = 15;
-    static constexpr size_t test_operator_count = 14;
-    static constexpr size_t test_operator_symbols_len = 12;
-
-    static const char* test_keywords[] {
-        "use",
-        "let",
-        "mut",
-        "val",
-        "ref",
-        "fun",
-        "object",
-        "field",
-        "end",
-        "ret",
-        "if",
-        "else",
-        "while",
-        "each",
-        "in"
+
+    /// @note Character class bits for the byte lookup table below.
+    enum CharClassBits : unsigned char
+    {
+        char_class_none = 0,
+        char_class_space = 1,
+        char_class_alpha = 2,
+        char_class_numeric = 4,
+        char_class_operator = 8
     };
 
-    static const char* test_operators[] {
-        "?",
-        "+",
-        "-",
-        "*",
-        "/",
-        "==",
-        "!=",
-        "<",
-        ">",
-        "<=",
-        ">=",
-        "&&",
-        "||",
-        "="
+    struct LexemeEntry
+    {
+        std::string_view text;
+        TokenType type;
     };
 
-    static TokenType test_operator_lextypes[] {
-        token_op_nonil,
-        token_op_plus,
-        token_op_minus,
-        token_op_times,
-        token_op_slash,
-        token_op_isequal,
-        token_op_unequal,
-        token_op_lt,
-        token_op_gt,
-        token_op_lte,
-        token_op_gte,
-        token_op_logic_and,
-        token_op_logic_or,
-        token_op_assign
+    static constexpr size_t test_keyword_count = 16;
+    static constexpr size_t test_operator_count = 14;
+    static constexpr size_t test_lexeme_max_len = 6;
+
+    /// @note Both tables must stay ordered by lexeme length for the bucket lookup.
+    static constexpr LexemeEntry test_keywords[test_keyword_count] {
+        {"if", token_keyword_if},
+        {"in", token_keyword_in},
+        {"use", token_keyword_use},
+        {"nil", token_special_nil},
+        {"let", token_keyword_let},
+        {"mut", token_keyword_mut},
+        {"val", token_keyword_val},
+        {"ref", token_keyword_ref},
+        {"fun", token_keyword_fun},
+        {"end", token_keyword_end},
+        {"ret", token_keyword_ret},
+        {"else", token_keyword_else},
+        {"each", token_keyword_each},
+        {"field", token_keyword_field},
+        {"while", token_keyword_while},
+        {"object", token_keyword_object}
     };
 
-    constexpr bool isWhitespace(char c)
-    {
-        return c == test_sp || c == test_tb || c == test_cr || c == test_lf;
-    }
+    static constexpr LexemeEntry test_operators[test_operator_count] {
+        {"?", token_op_nonil},
+        {"+", token_op_plus},
+        {"-", token_op_minus},
+        {"*", token_op_times},
+        {"/", token_op_slash},
+        {"<", token_op_lt},
+        {">", token_op_gt},
+        {"=", token_op_assign},
+        {"==", token_op_isequal},
+        {"!=", token_op_unequal},
+        {"<=", token_op_lte},
+        {">=", token_op_gte},
+        {"&&", token_op_logic_and},
+        {"||", token_op_logic_or}
+    };
 
-    constexpr bool isAlphabetic(char c)
+    /// @brief Holds the index range of every lexeme length within a length-ordered table.
+    struct LexemeBuckets
     {
-        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '_';
-    }
+        size_t starts[test_lexeme_max_len + 2];
+    };
 
-    bool isOperatorSymbol(char c)
+    template <size_t N>
+    constexpr LexemeBuckets makeLexemeBuckets(const LexemeEntry (&table)[N])
     {
-        for (size_t symbol_i = 0; symbol_i < test_operator_symbols_len; symbol_i++)
+        LexemeBuckets buckets {};
+        size_t entry_i = 0;
+
+        for (size_t length = 0; length <= test_lexeme_max_len + 1; length++)
         {
-            if (c == test_operator_symbols[symbol_i])
+            while (entry_i < N && table[entry_i].text.length() < length)
             {
-                return true;
+                entry_i++;
             }
+
+            buckets.starts[length] = entry_i;
         }
 
-        return false;
+        return buckets;
     }
 
-    constexpr bool isNumeric(char c)
+    static constexpr LexemeBuckets test_keyword_buckets = makeLexemeBuckets(test_keywords);
+    static constexpr LexemeBuckets test_operator_buckets = makeLexemeBuckets(test_operators);
+
+    /// @brief Finds a lexeme's type by only comparing against table entries of the same length. Gives `fallback` on no match.
+    template <size_t N>
+    constexpr TokenType lookupLexeme(const LexemeEntry (&table)[N], const LexemeBuckets& buckets, std::string_view lexeme, TokenType fallback)
     {
-        return (c >= '0' && c <= '9') || c == '.';
+        size_t length = lexeme.length();
+
+        if (length == 0 || length > test_lexeme_max_len)
+        {
+            return fallback;
+        }
+
+        for (size_t entry_i = buckets.starts[length]; entry_i < buckets.starts[length + 1]; entry_i++)
+        {
+            if (table[entry_i].text == lexeme)
+            {
+                return table[entry_i].type;
+            }
+        }
+
+        return fallback;
     }
 
-    /* Lexer */
+    static_assert(lookupLexeme(test_keywords, test_keyword_buckets, "object", token_identifier) == token_keyword_object);
+    static_assert(lookupLexeme(test_keywords, test_keyword_buckets, "objects", token_identifier) == token_identifier);
+    static_assert(lookupLexeme(test_operators, test_operator_buckets, "<=", token_bad) == token_op_lte);
 
-    Lexer::Lexer(const char* source_cstr, size_t source_size)
-    : operators {}, keywords {}, source_view {source_cstr}, position {0}, limit {source_size}
+    constexpr unsigned char classifyChar(char c)
     {
-        for (size_t operator_i = 0; operator_i < test_operator_count; operator_i++)
+        switch (c)
         {
-            operators.insert({test_operators[operator_i], test_operator_lextypes[operator_i]});
+        case ' ':
+        case '\t':
+        case '\r':
+        case '\n':
+            return char_class_space;
+        case '_':
+            return char_class_alpha;
+        case '.':
+            return char_class_numeric;
+        case '?':
+        case '+':
+        case '-':
+        case '*':
+        case '/':
+        case '=':
+        case '!':
+        case '<':
+        case '>':
+        case '&':
+        case '|':
+            return char_class_operator;
+        default:
+            break;
         }
 
-        for (size_t keyword_i = 0; keyword_i < test_keyword_count; keyword_i++)
+        if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z'))
         {
-            keywords.insert(test_keywords[keyword_i]);
+            return char_class_alpha;
         }
+
+        if (c >= '0' && c <= '9')
+        {
+            return char_class_numeric;
+        }
+
+        return char_class_none;
+    }
+
+    struct CharClassTable
+    {
+        unsigned char classes[256];
+    };
+
+    constexpr CharClassTable makeCharClassTable()
+    {
+        CharClassTable table {};
+
+        for (size_t byte_i = 0; byte_i < 256; byte_i++)
+        {
+            table.classes[byte_i] = classifyChar(static_cast<char>(byte_i));
+        }
+
+        return table;
+    }
+
+    static constexpr CharClassTable test_char_classes = makeCharClassTable();
+
+    constexpr bool hasCharClass(char c, CharClassBits class_bit)
+    {
+        return (test_char_classes.classes[static_cast<unsigned char>(c)] & class_bit) != 0;
+    }
+
+    constexpr bool isWhitespace(char c)
+    {
+        return hasCharClass(c, char_class_space);
+    }
+
+    constexpr bool isAlphabetic(char c)
+    {
+        return hasCharClass(c, char_class_alpha);
+    }
+
+    constexpr bool isOperatorSymbol(char c)
+    {
+        return hasCharClass(c, char_class_operator);
+    }
+
+    constexpr bool isNumeric(char c)
+    {
+        return hasCharClass(c, char_class_numeric);
     }
 
+    /* Lexer */
+
+    Lexer::Lexer(const char* source_cstr, size_t source_size)
+    : source_view {source_cstr, source_size}, kernels {&getScanKernels()}, position {0}, limit {source_size}
+    {}
+
+    Lexer::Lexer(std::string_view source)
+    : source_view {source}, kernels {&getScanKernels()}, position {0}, limit {source.size()}
+    {}
+
+    Lexer::Lexer(const char* source_cstr, size_t source_size, ScanKernelLevel scan_level)
+    : source_view {source_cstr, source_size}, kernels {&getScanKernels(scan_level)}, position {0}, limit {source_size}
+    {}
+
     void Lexer::reset(const char* source_cptr, size_t source_size)
     {
-        source_view = source_cptr;
+        source_view = std::string_view {source_cptr, source_size};
         position = 0;
         limit = source_size;
     }
@@ -141,80 +248,43 @@ namespace fung::frontend
         position++;
 
         size_t token_begin = position;
-        size_t token_length = 0;
-        char temp;
 
-        while (position < limit)
-        {
-            temp = source_view[position];
+        position = kernels->find_byte(source_view.data(), position, limit, c);
 
-            if (temp == c)
-            {
-                position++;
-                break;
-            }
+        size_t token_length = position - token_begin;
 
-            token_length++;
+        /// @note skip the closing character if the source did not end first
+        if (position < limit)
+        {
             position++;
         }
 
-        return (Token) {.begin = token_begin, .length = token_length, .type = lexical_type};
+        uint32_t symbol = (lexical_type == token_string) ? internSymbol(source_view.substr(token_begin, token_length)) : no_symbol;
+
+        return (Token) {.begin = token_begin, .length = token_length, .type = lexical_type, .symbol = symbol};
     }
 
     Token Lexer::lexWhitespace()
     {
         size_t token_begin = position;
-        size_t token_length = 0;
-        char temp;
-
-        while (position < limit)
-        {
-            temp = source_view[position];
 
-            if (!isWhitespace(temp))
-            {
-                break;
-            }
-
-            token_length++;
-            position++;
-        }
+        position = kernels->skip_whitespace(source_view.data(), position, limit);
 
-        return (Token) {.begin = token_begin, .length = token_length, .type = token_whitespace};
+        return (Token) {.begin = token_begin, .length = position - token_begin, .type = token_whitespace};
     }
 
     Token Lexer::lexWord()
     {
         size_t token_begin = position;
-        size_t token_length = 0;
-        char temp;
-
-        while (position < limit)
-        {
-            temp = source_view[position];
-
-            if (!isAlphabetic(temp))
-            {
-                break;
-            }
-
-            token_length++;
-            position++;
-        }
-
-        std::string lexeme_str {};
 
-        for (size_t lexeme_i = 0; lexeme_i < token_length; lexeme_i++)
-        {
-            lexeme_str += source_view[token_begin + lexeme_i];
-        }
+        position = kernels->skip_alphabetic(source_view.data(), position, limit);
 
-        if (keywords.find(lexeme_str) != keywords.end())
-        {
-            return (Token) {.begin = token_begin, .length = token_length, .type = token_keyword};
-        }
+        size_t token_length = position - token_begin;
+        std::string_view word = source_view.substr(token_begin, token_length);
+        TokenType word_type = lookupLexeme(test_keywords, test_keyword_buckets, word, token_identifier);
+        uint32_t symbol = (word_type == token_identifier) ? internSymbol(word) : no_symbol;
 
-        return (Token) {.begin = token_begin, .length = token_length, .type = token_identifier};
+        return (Token) {.begin = token_begin, .length = token_length, .type = word_type, .symbol = symbol};
     }
 
     Token Lexer::lexOperator()
@@ -236,19 +306,9 @@ namespace fung::frontend
             position++;
         }
 
-        std::string lexeme_str {};
+        TokenType operator_type = lookupLexeme(test_operators, test_operator_buckets, source_view.substr(token_begin, token_length), token_bad);
 
-        for (size_t lexeme_i = 0; lexeme_i < token_length; lexeme_i++)
-        {
-            lexeme_str += source_view[token_begin + lexeme_i];
-        }
-
-        if (operators.find(lexeme_str) != operators.end())
-        {
-            return (Token) {.begin = token_begin, .length = token_length, .type = operators.at(lexeme_str)};
-        }
-
-        return (Token) {.begin = token_begin, .length = token_length, .type = token_bad};
+        return (Token) {.begin = token_begin, .length = token_length, .type = operator_type};
     }
 
     Token Lexer::lexSpecialLiteral()
@@ -257,6 +317,13 @@ namespace fung::frontend
         position++;
 
         size_t token_begin = position - 1;
+
+        /// @note A '$' ending the source has no letter after it. Mapped sources end at the mapping, so reading on would fault.
+        if (position >= limit)
+        {
+            return (Token) {.begin = token_begin, .length = 1, .type = token_bad};
+        }
+
         char special_c = source_view[position];
 
         position++;
@@ -0,0 +1,687 @@
+/**
+ * @file parser.cpp
+ * @author DrkWithT
+ * @brief Implements the recursive descent parser.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <charconv>
+#include <stdexcept>
+#include <utility>
+#include "frontend/parser.hpp"
+
+using namespace fung::syntax;
+
+namespace fung::frontend
+{
+    /// @note Thrown within the Parser only. parseFile converts it into a ParserDumpState.
+    class ParseError : public std::runtime_error
+    {
+    private:
+        Token token;
+        ParserStatus status;
+        const char* message;
+    public:
+        /// @note The message must be a string literal since it outlives the exception in ParserDumpState.
+        ParseError(const Token& error_token, ParserStatus error_status, const char* message_literal)
+        : std::runtime_error {message_literal}, token {error_token}, status {error_status}, message {message_literal}
+        {}
+
+        const Token& getToken() const
+        {
+            return token;
+        }
+
+        ParserStatus getStatus() const
+        {
+            return status;
+        }
+
+        const char* getMessage() const
+        {
+            return message;
+        }
+    };
+
+    /* ProgramUnit impl. */
+
+    ProgramUnit::ProgramUnit(const std::string& unit_name)
+    : arena {}, exprs {}, statements {}, source {}, name {unit_name}
+    {}
+
+    ProgramUnit::ProgramUnit(const std::string& unit_name, SourceFile source_file)
+    : arena {}, exprs {}, statements {}, source(std::move(source_file)), name {unit_name}
+    {}
+
+    AstArena& ProgramUnit::getArena()
+    {
+        return arena;
+    }
+
+    ExprPool& ProgramUnit::getExprPool()
+    {
+        return exprs;
+    }
+
+    const ExprPool& ProgramUnit::getExprPool() const
+    {
+        return exprs;
+    }
+
+    void ProgramUnit::addStatement(IStmt* stmt)
+    {
+        statements.push_back(stmt);
+    }
+
+    const std::vector<IStmt*>& ProgramUnit::getStatements() const
+    {
+        return statements;
+    }
+
+    std::string_view ProgramUnit::getSource() const
+    {
+        return source.getView();
+    }
+
+    const std::string& ProgramUnit::getName() const
+    {
+        return name;
+    }
+
+    /* Parser helpers */
+
+    Parser::Parser(const std::string_view& source_view)
+    : tokens {}, source {source_view}, arena {nullptr}, exprs {nullptr}, child_scratch {}, cursor {0}, previous {}, current {}, lexed_ok {false}
+    {
+        lexed_ok = tokens.lexSource(source_view, false);
+        current = tokens.getToken(0);
+    }
+
+    void Parser::advance()
+    {
+        previous = current;
+        cursor++;
+        current = tokens.getToken(cursor);
+    }
+
+    bool Parser::match(TokenType type) const
+    {
+        return current.type == type;
+    }
+
+    void Parser::consume(TokenType type, const char* message)
+    {
+        if (!match(type))
+        {
+            throw ParseError {current, fung_parse_unexpected_token, message};
+        }
+
+        advance();
+    }
+
+    template <typename NodeType, typename... Args>
+    NodeType* Parser::makeNode(Args&&... args)
+    {
+        return arena->create<NodeType>(std::forward<Args>(args)...);
+    }
+
+    ExprRange Parser::commitChildren(size_t scratch_mark)
+    {
+        ExprRange range = exprs->addChildren(child_scratch.data() + scratch_mark, child_scratch.size() - scratch_mark);
+
+        child_scratch.resize(scratch_mark);
+
+        return range;
+    }
+
+    template <typename AddStmtFn>
+    void Parser::parseBlock(AddStmtFn add_stmt)
+    {
+        while (!match(token_keyword_end) && !match(token_eof))
+        {
+            add_stmt(parseSubStmt());
+        }
+
+        consume(token_keyword_end, "Expected 'end' to close block.");
+    }
+
+    FungOperatorType Parser::toOperator(TokenType type) const
+    {
+        switch (type)
+        {
+        case token_op_nonil:
+            return fung_op_nonil;
+        case token_op_plus:
+            return fung_op_plus;
+        case token_op_minus:
+            return fung_op_minus;
+        case token_op_times:
+            return fung_op_times;
+        case token_op_slash:
+            return fung_op_slash;
+        case token_op_isequal:
+            return fung_op_isequal;
+        case token_op_unequal:
+            return fung_op_unequal;
+        case token_op_lt:
+            return fung_op_lt;
+        case token_op_gt:
+            return fung_op_gt;
+        case token_op_lte:
+            return fung_op_lte;
+        case token_op_gte:
+            return fung_op_gte;
+        case token_op_logic_and:
+            return fung_op_logic_and;
+        case token_op_logic_or:
+            return fung_op_logic_or;
+        default:
+            throw ParseError {current, fung_parse_unexpected_token, "Expected an operator."};
+        }
+    }
+
+    /* Expression parsing */
+
+    ExprRef Parser::parseElement()
+    {
+        Token literal = current;
+        std::string_view lexeme = source.substr(literal.begin, literal.length);
+
+        switch (literal.type)
+        {
+        case token_special_nil:
+            advance();
+            return exprs->emplace<ElementExpr>(std::monostate {}, fung_simple_type_nil);
+        case token_special_true:
+            advance();
+            return exprs->emplace<ElementExpr>(true, fung_simple_type_bool);
+        case token_special_false:
+            advance();
+            return exprs->emplace<ElementExpr>(false, fung_simple_type_bool);
+        case token_string:
+            advance();
+            return exprs->emplace<ElementExpr>(literal, fung_simple_type_string);
+        case token_integer:
+        {
+            int64_t int_value = 0;
+
+            if (std::from_chars(lexeme.data(), lexeme.data() + lexeme.size(), int_value).ec != std::errc {})
+            {
+                throw ParseError {literal, fung_parse_generic_error, "Integer literal is out of range."};
+            }
+
+            advance();
+            return exprs->emplace<ElementExpr>(int_value, fung_simple_type_int);
+        }
+        case token_float:
+        {
+            double float_value = 0.0;
+
+            if (std::from_chars(lexeme.data(), lexeme.data() + lexeme.size(), float_value).ec != std::errc {})
+            {
+                throw ParseError {literal, fung_parse_generic_error, "Invalid float literal."};
+            }
+
+            advance();
+            return exprs->emplace<ElementExpr>(float_value, fung_simple_type_float);
+        }
+        case token_lbrack:
+        {
+            size_t scratch_mark = child_scratch.size();
+
+            advance();
+
+            while (!match(token_rbrack))
+            {
+                /// @note Parse first since nested lists push onto the scratch too.
+                ExprRef item = parseBinary();
+
+                child_scratch.push_back(item);
+
+                if (!match(token_comma))
+                {
+                    break;
+                }
+
+                advance();
+            }
+
+            consume(token_rbrack, "Expected ']' to close list.");
+            return exprs->emplace<ElementExpr>(commitChildren(scratch_mark), fung_simple_type_list);
+        }
+        default:
+            throw ParseError {literal, fung_parse_unexpected_token, "Expected an expression."};
+        }
+    }
+
+    ExprRef Parser::parseCall(Token identifier)
+    {
+        size_t scratch_mark = child_scratch.size();
+
+        consume(token_lparen, "Expected '(' to begin call arguments.");
+
+        while (!match(token_rparen))
+        {
+            ExprRef arg = parseBinary();
+
+            child_scratch.push_back(arg);
+
+            if (!match(token_comma))
+            {
+                break;
+            }
+
+            advance();
+        }
+
+        consume(token_rparen, "Expected ')' to end call arguments.");
+
+        return exprs->emplace<CallExpr>(identifier, commitChildren(scratch_mark));
+    }
+
+    ExprRef Parser::parseAccess()
+    {
+        if (!match(token_identifier))
+        {
+            return parseElement();
+        }
+
+        Token identifier = current;
+
+        advance();
+
+        if (match(token_lbrace))
+        {
+            size_t scratch_mark = child_scratch.size();
+
+            advance();
+
+            while (!match(token_rbrace))
+            {
+                ExprRef field = parseBinary();
+
+                child_scratch.push_back(field);
+
+                if (!match(token_comma))
+                {
+                    break;
+                }
+
+                advance();
+            }
+
+            consume(token_rbrace, "Expected '}' to close object literal.");
+            return exprs->emplace<ElementExpr>(ObjectLiteral {identifier, commitChildren(scratch_mark)}, fung_simple_type_object);
+        }
+
+        ExprRef call {};
+
+        if (match(token_lparen))
+        {
+            call = parseCall(identifier);
+
+            if (!match(token_lbrack))
+            {
+                return call;
+            }
+        }
+
+        size_t scratch_mark = child_scratch.size();
+
+        while (match(token_lbrack))
+        {
+            advance();
+
+            ExprRef key = parseElement();
+            FungSimpleType key_type = exprs->getElement(key).getType();
+
+            if (key_type != fung_simple_type_string && key_type != fung_simple_type_int)
+            {
+                throw ParseError {previous, fung_parse_unexpected_token, "Access keys must be string or integer literals."};
+            }
+
+            child_scratch.push_back(key);
+            consume(token_rbrack, "Expected ']' after access key.");
+        }
+
+        ExprRange keys = commitChildren(scratch_mark);
+
+        if (!call.isNull())
+        {
+            return exprs->emplace<AccessExpr>(call, keys);
+        }
+
+        return exprs->emplace<AccessExpr>(identifier, keys);
+    }
+
+    ExprRef Parser::parseUnary()
+    {
+        if (match(token_op_minus) || match(token_op_nonil))
+        {
+            FungOperatorType op = toOperator(current.type);
+
+            advance();
+
+            return exprs->emplace<UnaryExpr>(parseUnary(), op);
+        }
+
+        return parseAccess();
+    }
+
+    ExprRef Parser::parseFactor()
+    {
+        ExprRef expr = parseUnary();
+
+        while (match(token_op_times) || match(token_op_slash))
+        {
+            FungOperatorType op = toOperator(current.type);
+
+            advance();
+
+            expr = exprs->emplace<BinaryExpr>(expr, parseUnary(), op);
+        }
+
+        return expr;
+    }
+
+    ExprRef Parser::parseTerm()
+    {
+        ExprRef expr = parseFactor();
+
+        while (match(token_op_plus) || match(token_op_minus))
+        {
+            FungOperatorType op = toOperator(current.type);
+
+            advance();
+
+            expr = exprs->emplace<BinaryExpr>(expr, parseFactor(), op);
+        }
+
+        return expr;
+    }
+
+    ExprRef Parser::parseComparison()
+    {
+        ExprRef expr = parseTerm();
+
+        while (match(token_op_isequal) || match(token_op_unequal) || match(token_op_lt) || match(token_op_gt) || match(token_op_lte) || match(token_op_gte))
+        {
+            FungOperatorType op = toOperator(current.type);
+
+            advance();
+
+            expr = exprs->emplace<BinaryExpr>(expr, parseTerm(), op);
+        }
+
+        return expr;
+    }
+
+    ExprRef Parser::parseBinary()
+    {
+        ExprRef expr = parseComparison();
+
+        while (match(token_op_logic_and) || match(token_op_logic_or))
+        {
+            FungOperatorType op = toOperator(current.type);
+
+            advance();
+
+            expr = exprs->emplace<BinaryExpr>(expr, parseComparison(), op);
+        }
+
+        return expr;
+    }
+
+    ExprRef Parser::parseExpr()
+    {
+        return parseBinary();
+    }
+
+    /* Statement parsing */
+
+    IStmt* Parser::parseUse()
+    {
+        advance();
+        consume(token_identifier, "Expected module name after 'use'.");
+
+        return makeNode<UseStmt>(previous);
+    }
+
+    IStmt* Parser::parseVar()
+    {
+        bool is_let = match(token_keyword_let);
+
+        advance();
+        consume(token_identifier, "Expected variable name.");
+
+        Token name = previous;
+
+        consume(token_op_assign, "Expected '=' after variable name.");
+
+        return makeNode<VarStmt>(parseExpr(), name, is_let);
+    }
+
+    IStmt* Parser::parseFunc()
+    {
+        advance();
+        consume(token_identifier, "Expected function name.");
+
+        FuncDecl* func = makeNode<FuncDecl>(*arena, previous);
+
+        consume(token_lparen, "Expected '(' to begin parameters.");
+
+        while (match(token_keyword_val) || match(token_keyword_ref))
+        {
+            bool is_value = match(token_keyword_val);
+
+            advance();
+            consume(token_identifier, "Expected parameter name.");
+            func->emplaceParam(previous, is_value);
+
+            if (!match(token_comma))
+            {
+                break;
+            }
+
+            advance();
+        }
+
+        consume(token_rparen, "Expected ')' to end parameters.");
+
+        parseBlock([func](IStmt* stmt) {
+            func->addBodyStmt(stmt);
+        });
+
+        return func;
+    }
+
+    IStmt* Parser::parseObject()
+    {
+        advance();
+        consume(token_identifier, "Expected object type name.");
+
+        ObjectDecl* object = makeNode<ObjectDecl>(*arena, previous);
+
+        while (match(token_keyword_field))
+        {
+            advance();
+            consume(token_identifier, "Expected field name.");
+            object->emplaceField(previous);
+        }
+
+        consume(token_keyword_end, "Expected 'end' to close object declaration.");
+
+        return object;
+    }
+
+    IStmt* Parser::parseReturn()
+    {
+        advance();
+
+        /// @note A bare `ret` just before `end` returns nil.
+        if (match(token_keyword_end))
+        {
+            return makeNode<ReturnStmt>(ExprRef {});
+        }
+
+        return makeNode<ReturnStmt>(parseExpr());
+    }
+
+    IStmt* Parser::parseIf()
+    {
+        advance();
+
+        ExprRef conditional = parseExpr();
+        BlockStmt body {*arena};
+
+        parseBlock([&body](IStmt* stmt) {
+            body.addStmt(stmt);
+        });
+
+        IStmt* other = nullptr;
+
+        if (match(token_keyword_else))
+        {
+            advance();
+
+            ElseStmt* else_stmt = makeNode<ElseStmt>(*arena);
+
+            parseBlock([else_stmt](IStmt* stmt) {
+                else_stmt->addStmt(stmt);
+            });
+
+            other = else_stmt;
+        }
+
+        return makeNode<IfStmt>(std::move(body), conditional, other);
+    }
+
+    IStmt* Parser::parseWhile()
+    {
+        advance();
+
+        WhileStmt* loop = makeNode<WhileStmt>(*arena, parseExpr());
+
+        parseBlock([loop](IStmt* stmt) {
+            loop->addStmt(stmt);
+        });
+
+        return loop;
+    }
+
+    IStmt* Parser::parseEach()
+    {
+        advance();
+        consume(token_identifier, "Expected item name after 'each'.");
+
+        Token item_name = previous;
+
+        consume(token_keyword_in, "Expected 'in' after item name.");
+
+        EachStmt* loop = makeNode<EachStmt>(*arena, item_name, parseExpr());
+
+        parseBlock([loop](IStmt* stmt) {
+            loop->addStmt(stmt);
+        });
+
+        return loop;
+    }
+
+    IStmt* Parser::parseAssignOrCall()
+    {
+        Token target_token = current;
+        ExprRef target = parseAccess();
+
+        if (match(token_op_assign))
+        {
+            if (target.getKind() != nested_expr_access)
+            {
+                throw ParseError {target_token, fung_parse_unexpected_token, "Invalid assignment target."};
+            }
+
+            advance();
+
+            return makeNode<AssignStmt>(target, parseExpr());
+        }
+
+        if (target.getKind() != nested_expr_call)
+        {
+            throw ParseError {target_token, fung_parse_unexpected_token, "Expected a call or assignment."};
+        }
+
+        return makeNode<ExprStmt>(target);
+    }
+
+    IStmt* Parser::parseSubStmt()
+    {
+        switch (current.type)
+        {
+        case token_keyword_let:
+        case token_keyword_mut:
+            return parseVar();
+        case token_keyword_ret:
+            return parseReturn();
+        case token_keyword_if:
+            return parseIf();
+        case token_keyword_while:
+            return parseWhile();
+        case token_keyword_each:
+            return parseEach();
+        case token_identifier:
+            return parseAssignOrCall();
+        case token_keyword_use:
+        case token_keyword_fun:
+        case token_keyword_object:
+            throw ParseError {current, fung_parse_unexpected_token, "Declarations are only allowed at top level."};
+        default:
+            throw ParseError {current, fung_parse_unexpected_token, "Expected a statement."};
+        }
+    }
+
+    IStmt* Parser::parseStmt()
+    {
+        switch (current.type)
+        {
+        case token_keyword_use:
+            return parseUse();
+        case token_keyword_fun:
+            return parseFunc();
+        case token_keyword_object:
+            return parseObject();
+        default:
+            return parseSubStmt();
+        }
+    }
+
+    ParserDumpState Parser::parseFile(ProgramUnit& unit)
+    {
+        if (!lexed_ok)
+        {
+            return (ParserDumpState) {.error_token = current, .status = fung_parse_generic_error, .message = "Source is too large to tokenize."};
+        }
+
+        arena = &unit.getArena();
+        exprs = &unit.getExprPool();
+
+        try
+        {
+            while (!match(token_eof))
+            {
+                unit.addStatement(parseStmt());
+            }
+        }
+        catch (const ParseError& error)
+        {
+            return (ParserDumpState) {.error_token = error.getToken(), .status = error.getStatus(), .message = error.getMessage()};
+        }
+        catch (const std::length_error& error)
+        {
+            return (ParserDumpState) {.error_token = current, .status = fung_parse_generic_error, .message = "Too many expressions in one unit."};
+        }
+
+        return (ParserDumpState) {.error_token = current, .status = fung_parse_ok, .message = ""};
+    }
+}
@@ -0,0 +1,271 @@
+/**
+ * @file scankernels.cpp
+ * @author DrkWithT
+ * @brief Implements scalar and vectorized byte scanning for the tokenizer.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "frontend/scankernels.hpp"
+
+#if defined(__x86_64__)
+#define FUNG_SCAN_X86 1
+#include <immintrin.h>
+#else
+#define FUNG_SCAN_X86 0
+#endif
+
+namespace fung::frontend
+{
+    /* Scalar kernels */
+
+    constexpr bool isScanWhitespace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    constexpr bool isScanAlphabetic(char c)
+    {
+        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '_';
+    }
+
+    static size_t skipWhitespaceScalar(const char* data, size_t position, size_t limit)
+    {
+        while (position < limit && isScanWhitespace(data[position]))
+        {
+            position++;
+        }
+
+        return position;
+    }
+
+    static size_t skipAlphabeticScalar(const char* data, size_t position, size_t limit)
+    {
+        while (position < limit && isScanAlphabetic(data[position]))
+        {
+            position++;
+        }
+
+        return position;
+    }
+
+    static size_t findByteScalar(const char* data, size_t position, size_t limit, char target)
+    {
+        while (position < limit && data[position] != target)
+        {
+            position++;
+        }
+
+        return position;
+    }
+
+#if FUNG_SCAN_X86
+    /* SSE2 kernels: 16 bytes per step, with the scalar kernels finishing any tail. */
+
+    /// @note Gives a bitmask with bit i set when byte i of the block ends the run.
+    static inline unsigned int stopMaskWhitespace16(__m128i block)
+    {
+        __m128i spaces = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(block, _mm_set1_epi8('\t'))),
+            _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('\r')), _mm_cmpeq_epi8(block, _mm_set1_epi8('\n'))));
+
+        return ~static_cast<unsigned int>(_mm_movemask_epi8(spaces)) & 0xffffu;
+    }
+
+    /// @note Folding to lowercase with `| 0x20` keeps non-letters out of 'a'..'z', and bytes >= 0x80 compare as negative.
+    static inline unsigned int stopMaskAlphabetic16(__m128i block)
+    {
+        __m128i lowered = _mm_or_si128(block, _mm_set1_epi8(0x20));
+        __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(lowered, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(lowered, _mm_set1_epi8('z' + 1)));
+        __m128i word_chars = _mm_or_si128(letters, _mm_cmpeq_epi8(block, _mm_set1_epi8('_')));
+
+        return ~static_cast<unsigned int>(_mm_movemask_epi8(word_chars)) & 0xffffu;
+    }
+
+    static size_t skipWhitespaceSSE2(const char* data, size_t position, size_t limit)
+    {
+        while (position + 16 <= limit)
+        {
+            unsigned int stops = stopMaskWhitespace16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position)));
+
+            if (stops != 0)
+            {
+                return position + __builtin_ctz(stops);
+            }
+
+            position += 16;
+        }
+
+        return skipWhitespaceScalar(data, position, limit);
+    }
+
+    static size_t skipAlphabeticSSE2(const char* data, size_t position, size_t limit)
+    {
+        while (position + 16 <= limit)
+        {
+            unsigned int stops = stopMaskAlphabetic16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position)));
+
+            if (stops != 0)
+            {
+                return position + __builtin_ctz(stops);
+            }
+
+            position += 16;
+        }
+
+        return skipAlphabeticScalar(data, position, limit);
+    }
+
+    static size_t findByteSSE2(const char* data, size_t position, size_t limit, char target)
+    {
+        __m128i needle = _mm_set1_epi8(target);
+
+        while (position + 16 <= limit)
+        {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position));
+            unsigned int hits = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+
+            if (hits != 0)
+            {
+                return position + __builtin_ctz(hits);
+            }
+
+            position += 16;
+        }
+
+        return findByteScalar(data, position, limit, target);
+    }
+
+    /* AVX2 kernels: 32 bytes per step, compiled for AVX2 only within these functions. */
+
+    __attribute__((target("avx2")))
+    static size_t skipWhitespaceAVX2(const char* data, size_t position, size_t limit)
+    {
+        while (position + 32 <= limit)
+        {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + position));
+            __m256i spaces = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\t'))),
+                _mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8('\r')), _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\n'))));
+            unsigned int stops = ~static_cast<unsigned int>(_mm256_movemask_epi8(spaces));
+
+            if (stops != 0)
+            {
+                return position + __builtin_ctz(stops);
+            }
+
+            position += 32;
+        }
+
+        return skipWhitespaceSSE2(data, position, limit);
+    }
+
+    __attribute__((target("avx2")))
+    static size_t skipAlphabeticAVX2(const char* data, size_t position, size_t limit)
+    {
+        while (position + 32 <= limit)
+        {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + position));
+            __m256i lowered = _mm256_or_si256(block, _mm256_set1_epi8(0x20));
+            __m256i letters = _mm256_and_si256(_mm256_cmpgt_epi8(lowered, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), lowered));
+            __m256i word_chars = _mm256_or_si256(letters, _mm256_cmpeq_epi8(block, _mm256_set1_epi8('_')));
+            unsigned int stops = ~static_cast<unsigned int>(_mm256_movemask_epi8(word_chars));
+
+            if (stops != 0)
+            {
+                return position + __builtin_ctz(stops);
+            }
+
+            position += 32;
+        }
+
+        return skipAlphabeticSSE2(data, position, limit);
+    }
+
+    __attribute__((target("avx2")))
+    static size_t findByteAVX2(const char* data, size_t position, size_t limit, char target)
+    {
+        __m256i needle = _mm256_set1_epi8(target);
+
+        while (position + 32 <= limit)
+        {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + position));
+            unsigned int hits = static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+
+            if (hits != 0)
+            {
+                return position + __builtin_ctz(hits);
+            }
+
+            position += 32;
+        }
+
+        return findByteSSE2(data, position, limit, target);
+    }
+#endif
+
+    /* Kernel selection */
+
+    static const ScanKernels scalar_kernels {skipWhitespaceScalar, skipAlphabeticScalar, findByteScalar, scan_level_scalar};
+
+#if FUNG_SCAN_X86
+    static const ScanKernels sse2_kernels {skipWhitespaceSSE2, skipAlphabeticSSE2, findByteSSE2, scan_level_sse2};
+    static const ScanKernels avx2_kernels {skipWhitespaceAVX2, skipAlphabeticAVX2, findByteAVX2, scan_level_avx2};
+#endif
+
+    ScanKernelLevel detectScanKernelLevel()
+    {
+#if FUNG_SCAN_X86
+        static const ScanKernelLevel detected_level = []() {
+            __builtin_cpu_init();
+
+            if (__builtin_cpu_supports("avx2"))
+            {
+                return scan_level_avx2;
+            }
+
+            if (__builtin_cpu_supports("sse2"))
+            {
+                return scan_level_sse2;
+            }
+
+            return scan_level_scalar;
+        }();
+
+        return detected_level;
+#else
+        return scan_level_scalar;
+#endif
+    }
+
+    const ScanKernels& getScanKernels(ScanKernelLevel level)
+    {
+        ScanKernelLevel supported_level = detectScanKernelLevel();
+
+        if (level > supported_level)
+        {
+            level = supported_level;
+        }
+
+#if FUNG_SCAN_X86
+        switch (level)
+        {
+        case scan_level_avx2:
+            return avx2_kernels;
+        case scan_level_sse2:
+            return sse2_kernels;
+        default:
+            break;
+        }
+#endif
+
+        return scalar_kernels;
+    }
+
+    const ScanKernels& getScanKernels()
+    {
+        return getScanKernels(detectScanKernelLevel());
+    }
+}
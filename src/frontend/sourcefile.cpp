@@ -0,0 +1,169 @@
+/**
+ * @file sourcefile.cpp
+ * @author DrkWithT
+ * @brief Implements script loading by mmap or a plain read.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <cstring>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "frontend/sourcefile.hpp"
+
+namespace fung::frontend
+{
+    static constexpr const char* stdin_path = "-";
+    static constexpr size_t read_chunk_size = 65536;
+
+    SourceFile::SourceFile()
+    : read_buffer {}, mapping {nullptr}, mapping_size {0}, view {}
+    {}
+
+    SourceFile::~SourceFile()
+    {
+        release();
+    }
+
+    SourceFile::SourceFile(SourceFile&& other) noexcept
+    : read_buffer(std::move(other.read_buffer)), mapping {other.mapping}, mapping_size {other.mapping_size}, view {other.view}
+    {
+        other.mapping = nullptr;
+        other.mapping_size = 0;
+        other.view = {};
+    }
+
+    SourceFile& SourceFile::operator=(SourceFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+
+            read_buffer = std::move(other.read_buffer);
+            mapping = other.mapping;
+            mapping_size = other.mapping_size;
+            view = other.view;
+
+            other.mapping = nullptr;
+            other.mapping_size = 0;
+            other.view = {};
+        }
+
+        return *this;
+    }
+
+    bool SourceFile::readStream(int fd)
+    {
+        size_t capacity = read_chunk_size;
+        size_t used = 0;
+        auto buffer = std::make_unique<char[]>(capacity);
+
+        while (true)
+        {
+            if (used == capacity)
+            {
+                auto grown = std::make_unique<char[]>(capacity * 2);
+
+                std::memcpy(grown.get(), buffer.get(), used);
+                buffer = std::move(grown);
+                capacity *= 2;
+            }
+
+            ssize_t read_count = ::read(fd, buffer.get() + used, capacity - used);
+
+            if (read_count < 0)
+            {
+                return false;
+            }
+
+            if (read_count == 0)
+            {
+                break;
+            }
+
+            used += static_cast<size_t>(read_count);
+        }
+
+        read_buffer = std::move(buffer);
+        view = std::string_view {read_buffer.get(), used};
+
+        return true;
+    }
+
+    void SourceFile::release()
+    {
+        if (mapping != nullptr)
+        {
+            ::munmap(mapping, mapping_size);
+        }
+
+        read_buffer.reset();
+        mapping = nullptr;
+        mapping_size = 0;
+        view = {};
+    }
+
+    bool SourceFile::load(const char* path)
+    {
+        release();
+
+        if (std::strcmp(path, stdin_path) == 0)
+        {
+            return readStream(STDIN_FILENO);
+        }
+
+        int fd = ::open(path, O_RDONLY);
+
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        struct stat file_info {};
+        bool load_ok = ::fstat(fd, &file_info) == 0;
+
+        if (load_ok && S_ISREG(file_info.st_mode) && file_info.st_size > 0)
+        {
+            size_t file_size = static_cast<size_t>(file_info.st_size);
+            void* file_mapping = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (file_mapping != MAP_FAILED)
+            {
+                /// @note Lexing walks the bytes front to back, so let the kernel read ahead.
+                ::madvise(file_mapping, file_size, MADV_SEQUENTIAL);
+
+                mapping = file_mapping;
+                mapping_size = file_size;
+                view = std::string_view {static_cast<const char*>(file_mapping), file_size};
+            }
+            else
+            {
+                load_ok = readStream(fd);
+            }
+        }
+        else if (load_ok)
+        {
+            /// @note Pipes, devices and empty files have no useful size to map.
+            load_ok = readStream(fd);
+        }
+
+        ::close(fd);
+
+        return load_ok;
+    }
+
+    bool SourceFile::isMapped() const
+    {
+        return mapping != nullptr;
+    }
+
+    std::string_view SourceFile::getView() const
+    {
+        return view;
+    }
+}
@@ -0,0 +1,84 @@
+/**
+ * @file symbols.cpp
+ * @author DrkWithT
+ * @brief Implements the global symbol interner.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "frontend/symbols.hpp"
+
+namespace fung::frontend
+{
+    static constexpr uint32_t symbol_shard_count = 16;
+
+    /// @note A deque keeps each text's storage in place as the shard grows, so the map's views and views handed out stay valid.
+    struct SymbolShard
+    {
+        std::mutex lock;
+        std::unordered_map<std::string_view, uint32_t> ids;
+        std::deque<std::string> texts;
+    };
+
+    static SymbolShard symbol_shards[symbol_shard_count];
+
+    /// @note IDs interleave the shards: the n-th text of shard s gets n * symbol_shard_count + s + 1, which skips no_symbol.
+    uint32_t internSymbol(std::string_view text)
+    {
+        uint32_t shard_index = static_cast<uint32_t>(std::hash<std::string_view> {}(text) % symbol_shard_count);
+        SymbolShard& shard = symbol_shards[shard_index];
+        std::lock_guard<std::mutex> shard_guard {shard.lock};
+
+        if (auto id_it = shard.ids.find(text); id_it != shard.ids.end())
+        {
+            return id_it->second;
+        }
+
+        uint32_t symbol = static_cast<uint32_t>(shard.texts.size()) * symbol_shard_count + shard_index + 1;
+
+        shard.texts.emplace_back(text);
+        shard.ids.emplace(shard.texts.back(), symbol);
+
+        return symbol;
+    }
+
+    std::string_view getSymbolText(uint32_t symbol)
+    {
+        if (symbol == no_symbol)
+        {
+            return {};
+        }
+
+        SymbolShard& shard = symbol_shards[(symbol - 1) % symbol_shard_count];
+        size_t text_index = (symbol - 1) / symbol_shard_count;
+        std::lock_guard<std::mutex> shard_guard {shard.lock};
+
+        if (text_index >= shard.texts.size())
+        {
+            return {};
+        }
+
+        return shard.texts[text_index];
+    }
+
+    size_t getSymbolCount()
+    {
+        size_t count = 0;
+
+        for (auto& shard : symbol_shards)
+        {
+            std::lock_guard<std::mutex> shard_guard {shard.lock};
+
+            count += shard.texts.size();
+        }
+
+        return count;
+    }
+}
@@ -8,7 +8,7 @@
  *
  */
 
-#include <exception>
+#include <stdexcept>
 #include "frontend/token.hpp"
 
 namespace fung::frontend
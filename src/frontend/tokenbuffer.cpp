@@ -0,0 +1,154 @@
+/**
+ * @file tokenbuffer.cpp
+ * @author DrkWithT
+ * @brief Implements the packed token stream.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <limits>
+#include "frontend/tokenbuffer.hpp"
+
+namespace fung::frontend
+{
+    static_assert(token_rbrack <= std::numeric_limits<uint8_t>::max(), "TokenType must fit the 8-bit kind array.");
+
+    /// @note Rough tokens per source byte used to size the arrays before lexing.
+    static constexpr size_t token_density_divisor = 4;
+
+    TokenBuffer::TokenBuffer()
+    : offsets {}, lengths {}, types {}, symbols {}, long_lengths {}, trivia {}
+    {}
+
+    void TokenBuffer::pushToken(const Token& token)
+    {
+        uint32_t token_index = static_cast<uint32_t>(offsets.size());
+
+        offsets.push_back(static_cast<uint32_t>(token.begin));
+        types.push_back(static_cast<uint8_t>(token.type));
+        symbols.push_back(token.symbol);
+
+        if (token.length >= long_length_mark)
+        {
+            lengths.push_back(long_length_mark);
+            long_lengths.push_back((LongLength) {.index = token_index, .length = static_cast<uint32_t>(token.length)});
+            return;
+        }
+
+        lengths.push_back(static_cast<uint16_t>(token.length));
+    }
+
+    void TokenBuffer::pushTrivia(const Token& token)
+    {
+        trivia.push_back((TriviaSpan) {
+            .begin = static_cast<uint32_t>(token.begin),
+            .length = static_cast<uint32_t>(token.length),
+            .next_token = static_cast<uint32_t>(offsets.size()),
+            .type = static_cast<uint8_t>(token.type)
+        });
+    }
+
+    uint32_t TokenBuffer::lookupLongLength(size_t index) const
+    {
+        /// @note long_lengths is filled in token order, so it stays sorted by index.
+        auto entry_it = std::lower_bound(long_lengths.begin(), long_lengths.end(), index, [](const LongLength& entry, size_t target) {
+            return entry.index < target;
+        });
+
+        return (entry_it != long_lengths.end() && entry_it->index == index) ? entry_it->length : long_length_mark;
+    }
+
+    bool TokenBuffer::lexSource(std::string_view source, bool keep_trivia)
+    {
+        clear();
+
+        if (source.size() >= std::numeric_limits<uint32_t>::max())
+        {
+            return false;
+        }
+
+        size_t estimated_count = source.size() / token_density_divisor + 1;
+
+        offsets.reserve(estimated_count);
+        lengths.reserve(estimated_count);
+        types.reserve(estimated_count);
+        symbols.reserve(estimated_count);
+
+        Lexer lexer {source};
+        Token token {};
+
+        do
+        {
+            token = lexer.lexNext();
+
+            if (token.type == token_whitespace || token.type == token_comment)
+            {
+                if (keep_trivia)
+                {
+                    pushTrivia(token);
+                }
+
+                continue;
+            }
+
+            pushToken(token);
+        } while (token.type != token_eof);
+
+        return true;
+    }
+
+    void TokenBuffer::clear()
+    {
+        offsets.clear();
+        lengths.clear();
+        types.clear();
+        symbols.clear();
+        long_lengths.clear();
+        trivia.clear();
+    }
+
+    size_t TokenBuffer::getCount() const
+    {
+        return offsets.size();
+    }
+
+    Token TokenBuffer::getToken(size_t index) const
+    {
+        if (offsets.empty())
+        {
+            return (Token) {.begin = 0, .length = 1, .type = token_eof};
+        }
+
+        if (index >= offsets.size())
+        {
+            index = offsets.size() - 1;
+        }
+
+        size_t token_length = lengths[index];
+
+        if (token_length == long_length_mark)
+        {
+            token_length = lookupLongLength(index);
+        }
+
+        return (Token) {.begin = offsets[index], .length = token_length, .type = static_cast<TokenType>(types[index]), .symbol = symbols[index]};
+    }
+
+    TokenType TokenBuffer::getType(size_t index) const
+    {
+        if (types.empty())
+        {
+            return token_eof;
+        }
+
+        return static_cast<TokenType>(types[std::min(index, types.size() - 1)]);
+    }
+
+    const std::vector<TriviaSpan>& TokenBuffer::getTrivia() const
+    {
+        return trivia;
+    }
+}
@@ -9,60 +9,201 @@
  * 
  */
 
-#include <algorithm>
-#include <memory>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
-#include <fstream>
-#include "frontend/lexer.hpp"
+#include "driver/workerpool.hpp"
+#include "driver/compilation.hpp"
+#include "driver/program.hpp"
 
-using my_token_type = fung::frontend::TokenType;
+/// @note Pass "-" as a script path to read it from stdin.
+static constexpr const char* default_script_path = "./examples/test07.fung";
 
-[[nodiscard]] bool readAFile(const char* path, std::unique_ptr<char[]>& result, size_t* external_size)
-{
-    std::ifstream reader {path, std::ios::in};
+/// @note Prefix for the worker count option e.g `-j4`. Without it, all hardware threads are used.
+static constexpr const char* jobs_option_prefix = "-j";
 
-    if (!reader.is_open())
+/// @note Reports per-unit AST memory use: arena bytes and blocks for statements, node count and reserved bytes for expressions.
+static constexpr const char* ast_stats_option = "--ast-stats";
+
+/// @note Loads and saves compiled chunks beside each script, e.g `foo.fungc` for `foo.fung`, to skip lexing and parsing on warm starts.
+static constexpr const char* cache_option = "--cache";
+
+/// @note Prints each unit's bytecode before running it.
+static constexpr const char* disasm_option = "--disasm";
+
+/// @note Prints garbage collection counts, a histogram of pause times, and bytes promoted and freed after running.
+static constexpr const char* gc_stats_option = "--gc-stats";
+
+/// @note Sets the nursery size in KiB, e.g `--gc-nursery-kb=4096`. A larger nursery means fewer but longer minor collections.
+static constexpr const char* gc_nursery_option = "--gc-nursery-kb=";
+
+/// @note Sets how many KiB the old generation may grow to before the first major collection, e.g `--gc-heap-kb=65536`. After each one, the limit becomes twice the live size or this, whichever is larger.
+static constexpr const char* gc_heap_option = "--gc-heap-kb=";
+
+/// @note Sets the longest a single step of a major collection may pause the script for, in microseconds, e.g `--gc-pause-us=500`. Zero makes major collections stop the script until they are done.
+static constexpr const char* gc_pause_option = "--gc-pause-us=";
+
+/// @note Prints hit and miss counts of each field access site's inline cache after running.
+static constexpr const char* ic_stats_option = "--ic-stats";
+
+/// @note Caches results of pure functions, i.e those with only `val` parameters that touch no mutable state and do no I/O, then prints hit and miss counts on exit. Use `--memoize=<entries>` to bound the cache to other than the default size.
+static constexpr const char* memoize_option = "--memoize";
+
+/// @note Prints how many `?` nil checks in each function were proven redundant and left out of the bytecode.
+static constexpr const char* nil_stats_option = "--nil-stats";
+
+int main (int argc, char* argv[]) {
+    size_t worker_count = 0;
+    bool show_ast_stats = false;
+    bool use_cache = false;
+    bool show_disassembly = false;
+    bool show_ic_stats = false;
+    bool show_nil_stats = false;
+    bool show_gc_stats = false;
+    fung::backend::GcConfig gc_config {.nursery_bytes = fung::backend::Heap::default_nursery_bytes, .old_limit_bytes = fung::backend::Heap::default_old_limit_bytes, .pause_budget_us = fung::backend::Heap::default_pause_budget_us};
+    size_t memo_capacity = 0;
+    std::vector<const char*> script_paths {};
+
+    for (int arg_i = 1; arg_i < argc; arg_i++)
     {
-        return false;
+        const char* arg = argv[arg_i];
+
+        if (std::strncmp(arg, jobs_option_prefix, std::strlen(jobs_option_prefix)) == 0 && arg[std::strlen(jobs_option_prefix)] != '\0')
+        {
+            worker_count = std::strtoul(arg + std::strlen(jobs_option_prefix), nullptr, 10);
+            continue;
+        }
+
+        if (std::strcmp(arg, ast_stats_option) == 0)
+        {
+            show_ast_stats = true;
+            continue;
+        }
+
+        if (std::strcmp(arg, cache_option) == 0)
+        {
+            use_cache = true;
+            continue;
+        }
+
+        if (std::strcmp(arg, disasm_option) == 0)
+        {
+            show_disassembly = true;
+            continue;
+        }
+
+        if (std::strcmp(arg, gc_stats_option) == 0)
+        {
+            show_gc_stats = true;
+            continue;
+        }
+
+        if (std::strncmp(arg, gc_nursery_option, std::strlen(gc_nursery_option)) == 0)
+        {
+            gc_config.nursery_bytes = std::strtoul(arg + std::strlen(gc_nursery_option), nullptr, 10) * 1024;
+            continue;
+        }
+
+        if (std::strncmp(arg, gc_heap_option, std::strlen(gc_heap_option)) == 0)
+        {
+            gc_config.old_limit_bytes = std::strtoul(arg + std::strlen(gc_heap_option), nullptr, 10) * 1024;
+            continue;
+        }
+
+        if (std::strncmp(arg, gc_pause_option, std::strlen(gc_pause_option)) == 0)
+        {
+            gc_config.pause_budget_us = static_cast<uint32_t>(std::strtoul(arg + std::strlen(gc_pause_option), nullptr, 10));
+            continue;
+        }
+
+        if (std::strcmp(arg, ic_stats_option) == 0)
+        {
+            show_ic_stats = true;
+            continue;
+        }
+
+        if (std::strcmp(arg, memoize_option) == 0)
+        {
+            memo_capacity = fung::backend::MemoTable::default_capacity;
+            continue;
+        }
+
+        if (std::strncmp(arg, memoize_option, std::strlen(memoize_option)) == 0 && arg[std::strlen(memoize_option)] == '=')
+        {
+            memo_capacity = std::strtoul(arg + std::strlen(memoize_option) + 1, nullptr, 10);
+            continue;
+        }
+
+        if (std::strcmp(arg, nil_stats_option) == 0)
+        {
+            show_nil_stats = true;
+            continue;
+        }
+
+        script_paths.push_back(arg);
     }
 
-    size_t input_size = 0;
-    reader.seekg(0, std::ios::end);
-    input_size = reader.tellg();
-    reader.seekg(0, std::ios::beg);
+    if (script_paths.empty())
+    {
+        script_paths.push_back(default_script_path);
+    }
 
-    auto buffer = std::make_unique<char[]>(input_size + 1);
+    fung::driver::WorkerPool pool {worker_count};
+    fung::driver::Compilation compilation {pool, use_cache};
 
-    std::fill(buffer.get(), buffer.get() + input_size, '\0');
+    for (const char* path : script_paths)
+    {
+        compilation.addRoot(path);
+    }
 
-    bool read_ok = !reader.read(buffer.get(), input_size).bad();
+    compilation.run();
 
-    if (read_ok)
+    if (compilation.reportErrors(std::cerr) > 0)
     {
-        result.reset(buffer.release());
-        *external_size = input_size;
+        return 1;
     }
 
-    return read_ok;
-}
+    if (show_ast_stats)
+    {
+        for (const auto& result : compilation.getResults())
+        {
+            const auto& arena = result->unit->getArena();
+            const auto& exprs = result->unit->getExprPool();
 
-int main (int argc, char* argv[]) {
-    std::unique_ptr<char[]> source_buffer {};
-    size_t my_file_size = 0;
+            std::cout << result->path << ": parsed " << result->unit->getStatements().size() << " statements\n"
+                << "  stmt arena: " << arena.getUsedBytes() << " bytes in " << arena.getBlockCount() << " blocks\n"
+                << "  expr pool: " << exprs.getNodeCount() << " nodes in " << exprs.getReservedBytes() << " bytes\n";
+        }
+    }
+
+    fung::driver::Program program {compilation};
 
-    if (!readAFile("./examples/test07.fung", source_buffer, &my_file_size))
+    if (program.build({.gc_config = gc_config, .memo_capacity = memo_capacity, .write_cache = use_cache, .show_disassembly = show_disassembly}, std::cout, std::cerr) > 0)
     {
-        std::cerr << "Failed to read file :(\n";
         return 1;
     }
 
-    fung::frontend::Token temp_token {};
-    fung::frontend::Lexer lexer {source_buffer.get(), my_file_size};
+    if (show_nil_stats)
+    {
+        program.reportNilChecks(std::cout);
+    }
+
+    bool ran_ok = program.run(std::cerr);
 
-    do
+    if (show_ic_stats)
     {
-        temp_token = lexer.lexNext();
+        program.reportFieldCaches(std::cout);
+    }
+
+    program.reportMemo(std::cout);
 
-        std::cout << "Token {type=" << temp_token.type << ", begin=" << temp_token.begin << ", length=" << temp_token.length << "}\n";
-    } while (temp_token.type != my_token_type::token_eof);
+    if (show_gc_stats)
+    {
+        program.reportGc(std::cout);
+    }
+
+    if (!ran_ok)
+    {
+        return 1;
+    }
 }
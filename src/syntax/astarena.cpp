@@ -0,0 +1,93 @@
+/**
+ * @file astarena.cpp
+ * @author DrkWithT
+ * @brief Implements the AST node arena.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <cstdint>
+#include "syntax/astarena.hpp"
+
+namespace fung::syntax
+{
+    AstArena::AstArena()
+    : blocks {}, cursor {nullptr}, limit {nullptr}, used_bytes {0}
+    {}
+
+    AstArena::AstArena(AstArena&& other) noexcept
+    : blocks(std::move(other.blocks)), cursor {other.cursor}, limit {other.limit}, used_bytes {other.used_bytes}
+    {
+        other.cursor = nullptr;
+        other.limit = nullptr;
+        other.used_bytes = 0;
+    }
+
+    AstArena& AstArena::operator=(AstArena&& other) noexcept
+    {
+        if (this != &other)
+        {
+            blocks = std::move(other.blocks);
+            cursor = other.cursor;
+            limit = other.limit;
+            used_bytes = other.used_bytes;
+
+            other.cursor = nullptr;
+            other.limit = nullptr;
+            other.used_bytes = 0;
+        }
+
+        return *this;
+    }
+
+    void AstArena::addBlock(size_t min_size)
+    {
+        size_t block_size = (min_size > default_block_size) ? min_size : default_block_size;
+
+        blocks.emplace_back(std::make_unique<std::byte[]>(block_size));
+        cursor = blocks.back().get();
+        limit = cursor + block_size;
+    }
+
+    void* AstArena::allocate(size_t size, size_t alignment)
+    {
+        auto address = reinterpret_cast<uintptr_t>(cursor);
+        size_t padding = (alignment - (address % alignment)) % alignment;
+
+        if (cursor == nullptr || padding + size > static_cast<size_t>(limit - cursor))
+        {
+            /// @note Fresh blocks come from operator new, so they already meet fundamental alignment.
+            addBlock(size + alignment);
+
+            address = reinterpret_cast<uintptr_t>(cursor);
+            padding = (alignment - (address % alignment)) % alignment;
+        }
+
+        std::byte* slot = cursor + padding;
+
+        cursor = slot + size;
+        used_bytes += size;
+
+        return slot;
+    }
+
+    void AstArena::release()
+    {
+        blocks.clear();
+        cursor = nullptr;
+        limit = nullptr;
+        used_bytes = 0;
+    }
+
+    size_t AstArena::getUsedBytes() const
+    {
+        return used_bytes;
+    }
+
+    size_t AstArena::getBlockCount() const
+    {
+        return blocks.size();
+    }
+}
@@ -16,39 +16,13 @@ using FungToken = fung::frontend::Token;
 
 namespace fung::syntax
 {
-    /* CallExpr impl. */
-
-    CallExpr::CallExpr(FungToken& token)
-    : args {}, identifier {token}
-    {}
-
-    const FungToken& CallExpr::getIdentifierToken() const
-    {
-        return identifier;
-    }
-    
-    void CallExpr::addArgument(const ElementExpr& arg)
-    {
-        args.emplace_back(arg);
-    }
-    
-    const std::vector<ElementExpr>& CallExpr::getArguments() const
-    {
-        return args;
-    }
-
-    std::any CallExpr::accept(ExprVisitor<std::any>& visitor)
-    {
-        return visitor.visitCallExpr(*this);
-    }
-
     /* ElementExpr impl. */
 
-    ElementExpr::ElementExpr(std::any content_box, FungSimpleType element_type)
-    : content(std::move(content_box)), type {element_type}
+    ElementExpr::ElementExpr(ElementContent content_value, FungSimpleType element_type)
+    : content(std::move(content_value)), type {element_type}
     {}
 
-    const std::any& ElementExpr::getContent() const
+    const ElementContent& ElementExpr::getContent() const
     {
         return content;
     }
@@ -63,31 +37,43 @@ namespace fung::syntax
         return visitor.visitElementExpr(*this);
     }
 
-    /* AccessExpr impl. */
+    /* CallExpr impl. */
 
-    AccessExpr::AccessExpr(FungToken& token)
-    : keys {}, lvalue {}
+    CallExpr::CallExpr(const FungToken& token, ExprRange arg_range)
+    : args {arg_range}, identifier {token}
+    {}
+
+    const FungToken& CallExpr::getIdentifierToken() const
     {
-        lvalue = token;
+        return identifier;
     }
 
-    AccessExpr::AccessExpr(CallExpr& call_expr)
-    : keys {}, lvalue {}
+    ExprRange CallExpr::getArguments() const
     {
-        lvalue = call_expr;
+        return args;
     }
 
-    void AccessExpr::addAccessKey(ElementExpr& key_expr)
+    std::any CallExpr::accept(ExprVisitor<std::any>& visitor)
     {
-        keys.emplace_back(key_expr);
+        return visitor.visitCallExpr(*this);
     }
 
-    const std::vector<ElementExpr>& AccessExpr::getKeys() const
+    /* AccessExpr impl. */
+
+    AccessExpr::AccessExpr(const FungToken& token, ExprRange key_range)
+    : keys {key_range}, lvalue {token}
+    {}
+
+    AccessExpr::AccessExpr(ExprRef call_expr, ExprRange key_range)
+    : keys {key_range}, lvalue {call_expr}
+    {}
+
+    ExprRange AccessExpr::getKeys() const
     {
         return keys;
     }
 
-    const std::variant<FungToken, CallExpr>& AccessExpr::getLvalueVariant() const
+    const std::variant<FungToken, ExprRef>& AccessExpr::getLvalueVariant() const
     {
         return lvalue;
     }
@@ -99,11 +85,11 @@ namespace fung::syntax
 
     /* UnaryExpr impl. */
 
-    UnaryExpr::UnaryExpr(AccessExpr& inner_expr, FungOperatorType op_type)
+    UnaryExpr::UnaryExpr(ExprRef inner_expr, FungOperatorType op_type)
     : inner {inner_expr}, op {op_type}
     {}
 
-    const AccessExpr& UnaryExpr::getInnerExpr() const
+    ExprRef UnaryExpr::getInnerExpr() const
     {
         return inner;
     }
@@ -120,26 +106,18 @@ namespace fung::syntax
 
     /* BinaryExpr impl. */
 
-    BinaryExpr::BinaryExpr(UnaryExpr left_expr, UnaryExpr right_expr, FungOperatorType op_symbol)
-    : left {}, right {}, op {op_symbol}, nests_unaries {true}
-    {
-        left = left_expr;
-        right = right_expr;
-    }
-
-    BinaryExpr::BinaryExpr(BinaryExpr left_expr, BinaryExpr right_expr, FungOperatorType op_symbol)
-    : left {}, right {}, op {op_symbol}, nests_unaries {false}
+    BinaryExpr::BinaryExpr(ExprRef left_expr, ExprRef right_expr, FungOperatorType op_symbol)
+    : left {left_expr}, right {right_expr}, op {op_symbol}, nests_unaries {false}
     {
-        left = left_expr;
-        right = right_expr;
+        nests_unaries = left.getKind() != nested_expr_binary && right.getKind() != nested_expr_binary;
     }
 
-    const std::any& BinaryExpr::getLeftExpr() const
+    ExprRef BinaryExpr::getLeftExpr() const
     {
         return left;
     }
 
-    const std::any& BinaryExpr::getRightExpr() const
+    ExprRef BinaryExpr::getRightExpr() const
     {
         return right;
     }
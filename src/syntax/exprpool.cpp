@@ -0,0 +1,68 @@
+/**
+ * @file exprpool.cpp
+ * @author DrkWithT
+ * @brief Implements flat expression storage.
+ * @date 2026-10-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "syntax/exprpool.hpp"
+
+namespace fung::syntax
+{
+    ExprPool::ExprPool()
+    : calls {}, elements {}, accesses {}, unaries {}, binaries {}, child_refs {}
+    {}
+
+    ExprRange ExprPool::addChildren(const ExprRef* refs, size_t count)
+    {
+        auto start = static_cast<uint32_t>(child_refs.size());
+
+        child_refs.insert(child_refs.end(), refs, refs + count);
+
+        return ExprRange {start, static_cast<uint32_t>(count)};
+    }
+
+    const CallExpr& ExprPool::getCall(ExprRef ref) const
+    {
+        return calls[ref.getIndex()];
+    }
+
+    const ElementExpr& ExprPool::getElement(ExprRef ref) const
+    {
+        return elements[ref.getIndex()];
+    }
+
+    const AccessExpr& ExprPool::getAccess(ExprRef ref) const
+    {
+        return accesses[ref.getIndex()];
+    }
+
+    const UnaryExpr& ExprPool::getUnary(ExprRef ref) const
+    {
+        return unaries[ref.getIndex()];
+    }
+
+    const BinaryExpr& ExprPool::getBinary(ExprRef ref) const
+    {
+        return binaries[ref.getIndex()];
+    }
+
+    ExprRefSpan ExprPool::getChildren(ExprRange range) const
+    {
+        return ExprRefSpan {child_refs.data() + range.start, range.count};
+    }
+
+    size_t ExprPool::getNodeCount() const
+    {
+        return calls.size() + elements.size() + accesses.size() + unaries.size() + binaries.size();
+    }
+
+    size_t ExprPool::getReservedBytes() const
+    {
+        return calls.capacity() * sizeof(CallExpr) + elements.capacity() * sizeof(ElementExpr) + accesses.capacity() * sizeof(AccessExpr)
+            + unaries.capacity() * sizeof(UnaryExpr) + binaries.capacity() * sizeof(BinaryExpr) + child_refs.capacity() * sizeof(ExprRef);
+    }
+}
@@ -8,6 +8,7 @@
  * 
  */
 
+#include <utility>
 #include "syntax/statements.hpp"
 
 namespace fung::syntax
@@ -15,7 +16,7 @@ namespace fung::syntax
     /* UseStmt impl */
 
     UseStmt::UseStmt(const fung::frontend::Token& identifier_token)
-    : identifier {identifier_token}
+    : IStmt {nested_stmt_use}, identifier {identifier_token}
     {}
 
     const fung::frontend::Token& UseStmt::getIdentifier() const
@@ -30,11 +31,11 @@ namespace fung::syntax
 
     /* VarStmt impl. */
 
-    VarStmt::VarStmt(std::unique_ptr<IExpr> expr, const fung::frontend::Token& identifier_token, bool is_let)
-    : right_expr(std::move(expr)), identifier {identifier_token}, immutable_flag {is_let}
+    VarStmt::VarStmt(ExprRef expr, const fung::frontend::Token& identifier_token, bool is_let)
+    : IStmt {nested_stmt_var}, right_expr {expr}, identifier {identifier_token}, immutable_flag {is_let}
     {}
 
-    const std::unique_ptr<IExpr>& VarStmt::getRXpr() const
+    ExprRef VarStmt::getRXpr() const
     {
         return right_expr;
     }
@@ -57,7 +58,7 @@ namespace fung::syntax
     /* ParamDecl impl. */
 
     ParamDecl::ParamDecl(const fung::frontend::Token& idenfitier_token, bool is_value)
-    : identifier {idenfitier_token}, value_flag {is_value}
+    : IStmt {nested_stmt_param}, identifier {idenfitier_token}, value_flag {is_value}
     {}
 
     const fung::frontend::Token& ParamDecl::getIdentifier() const
@@ -76,18 +77,18 @@ namespace fung::syntax
     }
 
     /* FuncDecl impl. */
-    FuncDecl::FuncDecl(const fung::frontend::Token& name_token)
-    : body {}, params {}, name {name_token}
+    FuncDecl::FuncDecl(AstArena& arena, const fung::frontend::Token& name_token)
+    : IStmt {nested_stmt_func}, body {arena}, params {ArenaAllocator<ParamDecl> {arena}}, name {name_token}
     {}
 
-    void FuncDecl::addParam(const ParamDecl& param)
+    void FuncDecl::emplaceParam(const fung::frontend::Token& identifier_token, bool is_value)
     {
-        params.push_back(param);
+        params.emplace_back(identifier_token, is_value);
     }
 
-    void FuncDecl::addBodyStmt(std::unique_ptr<IStmt> stmt_ptr)
+    void FuncDecl::addBodyStmt(IStmt* stmt_ptr)
     {
-        body.addStmt(std::move(stmt_ptr));
+        body.addStmt(stmt_ptr);
     }
 
     const BlockStmt& FuncDecl::getBodyBlock() const
@@ -95,7 +96,7 @@ namespace fung::syntax
         return body;
     }
     
-    const std::vector<ParamDecl>& FuncDecl::getParams() const
+    const ArenaVector<ParamDecl>& FuncDecl::getParams() const
     {
         return params;
     }
@@ -113,7 +114,7 @@ namespace fung::syntax
     /* FieldDecl impl. */
 
     FieldDecl::FieldDecl(const fung::frontend::Token& field_name)
-    : name {field_name}
+    : IStmt {nested_stmt_field}, name {field_name}
     {}
 
     const fung::frontend::Token& FieldDecl::getName() const
@@ -128,18 +129,18 @@ namespace fung::syntax
 
     /* ObjectDecl */
 
-    ObjectDecl::ObjectDecl(const fung::frontend::Token& name)
-    : fields {}, type_name {name}
+    ObjectDecl::ObjectDecl(AstArena& arena, const fung::frontend::Token& name)
+    : IStmt {nested_stmt_object}, fields {ArenaAllocator<FieldDecl> {arena}}, type_name {name}
     {}
 
-    const std::vector<FieldDecl> ObjectDecl::getFields() const
+    const ArenaVector<FieldDecl>& ObjectDecl::getFields() const
     {
         return fields;
     }
     
-    void ObjectDecl::addField(const FieldDecl& field)
+    void ObjectDecl::emplaceField(const fung::frontend::Token& field_name)
     {
-        fields.push_back(field);
+        fields.emplace_back(field_name);
     }
 
     const fung::frontend::Token& ObjectDecl::getName() const
@@ -154,16 +155,16 @@ namespace fung::syntax
 
     /* AssignStmt impl. */
 
-    AssignStmt::AssignStmt(AccessExpr lvalue, std::unique_ptr<IExpr> rvalue)
-    : var_lvalue {lvalue}, var_rvalue(std::move(rvalue))
+    AssignStmt::AssignStmt(ExprRef lvalue, ExprRef rvalue)
+    : IStmt {nested_stmt_assign}, var_lvalue {lvalue}, var_rvalue {rvalue}
     {}
 
-    const AccessExpr& AssignStmt::getLValue() const
+    ExprRef AssignStmt::getLValue() const
     {
         return var_lvalue;
     }
 
-    const std::unique_ptr<IExpr>& AssignStmt::getRValue() const
+    ExprRef AssignStmt::getRValue() const
     {
         return var_rvalue;
     }
@@ -175,11 +176,11 @@ namespace fung::syntax
 
     /* ReturnStmt impl. */
 
-    ReturnStmt::ReturnStmt(std::unique_ptr<IExpr> result_expr)
-    : result(std::move(result_expr))
+    ReturnStmt::ReturnStmt(ExprRef result_expr)
+    : IStmt {nested_stmt_return}, result {result_expr}
     {}
 
-    const std::unique_ptr<IExpr>& ReturnStmt::getResult() const
+    ExprRef ReturnStmt::getResult() const
     {
         return result;
     }
@@ -191,8 +192,8 @@ namespace fung::syntax
 
     /* IfStmt impl. */
 
-    IfStmt::IfStmt(BlockStmt block_stmt, std::unique_ptr<IExpr> conditional_expr, std::unique_ptr<IStmt> other_stmt)
-    : body {block_stmt}, conditional(std::move(conditional_expr)), other(std::move(other_stmt))
+    IfStmt::IfStmt(BlockStmt&& block_stmt, ExprRef conditional_expr, IStmt* other_stmt)
+    : IStmt {nested_stmt_if}, body(std::move(block_stmt)), conditional {conditional_expr}, other {other_stmt}
     {}
 
     const BlockStmt& IfStmt::getBody() const
@@ -200,12 +201,12 @@ namespace fung::syntax
         return body;
     }
 
-    const std::unique_ptr<IExpr>& IfStmt::getConditional() const
+    ExprRef IfStmt::getConditional() const
     {
         return conditional;
     }
 
-    const std::unique_ptr<IStmt>& IfStmt::getOtherElse() const
+    IStmt* IfStmt::getOtherElse() const
     {
         return other;
     }
@@ -217,8 +218,8 @@ namespace fung::syntax
 
     /* ElseStmt impl. */
 
-    ElseStmt::ElseStmt()
-    : body {}
+    ElseStmt::ElseStmt(AstArena& arena)
+    : IStmt {nested_stmt_else}, body {arena}
     {}
 
     const BlockStmt& ElseStmt::getBody() const
@@ -226,9 +227,9 @@ namespace fung::syntax
         return body;
     }
 
-    void ElseStmt::addStmt(std::unique_ptr<IStmt> stmt)
+    void ElseStmt::addStmt(IStmt* stmt)
     {
-        body.addStmt(std::move(stmt));
+        body.addStmt(stmt);
     }
 
     std::any ElseStmt::accept(StmtVisitor<std::any>& visitor)
@@ -236,13 +237,29 @@ namespace fung::syntax
         return visitor.visitElseStmt(*this);
     }
 
+    /* ExprStmt impl. */
+
+    ExprStmt::ExprStmt(ExprRef inner_expr)
+    : IStmt {nested_stmt_expr}, inner {inner_expr}
+    {}
+
+    ExprRef ExprStmt::getInner() const
+    {
+        return inner;
+    }
+
+    std::any ExprStmt::accept(StmtVisitor<std::any>& visitor)
+    {
+        return visitor.visitExprStmt(*this);
+    }
+
     /* WhileStmt impl. */
 
-    WhileStmt::WhileStmt(std::unique_ptr<IExpr> conditional_expr)
-    : conditional(std::move(conditional_expr)), body {}
+    WhileStmt::WhileStmt(AstArena& arena, ExprRef conditional_expr)
+    : IStmt {nested_stmt_while}, conditional {conditional_expr}, body {arena}
     {}
 
-    const std::unique_ptr<IExpr>& WhileStmt::getConditional() const
+    ExprRef WhileStmt::getConditional() const
     {
         return conditional;
     }
@@ -252,9 +269,9 @@ namespace fung::syntax
         return body;
     }
 
-    void WhileStmt::addStmt(std::unique_ptr<IStmt> stmt)
+    void WhileStmt::addStmt(IStmt* stmt)
     {
-        body.addStmt(std::move(stmt));
+        body.addStmt(stmt);
     }
 
     std::any WhileStmt::accept(StmtVisitor<std::any>& visitor)
@@ -262,20 +279,51 @@ namespace fung::syntax
         return visitor.visitWhileStmt(*this);
     }
 
+    /* EachStmt impl. */
+
+    EachStmt::EachStmt(AstArena& arena, const fung::frontend::Token& item_token, ExprRef sequence_expr)
+    : IStmt {nested_stmt_each}, sequence {sequence_expr}, body {arena}, item_name {item_token}
+    {}
+
+    const fung::frontend::Token& EachStmt::getItemName() const
+    {
+        return item_name;
+    }
+
+    ExprRef EachStmt::getSequence() const
+    {
+        return sequence;
+    }
+
+    const BlockStmt& EachStmt::getBody() const
+    {
+        return body;
+    }
+
+    void EachStmt::addStmt(IStmt* stmt)
+    {
+        body.addStmt(stmt);
+    }
+
+    std::any EachStmt::accept(StmtVisitor<std::any>& visitor)
+    {
+        return visitor.visitEachStmt(*this);
+    }
+
     /* BlockStmt impl. */
 
-    BlockStmt::BlockStmt()
-    : body {}
+    BlockStmt::BlockStmt(AstArena& arena)
+    : IStmt {nested_stmt_block}, body {ArenaAllocator<IStmt*> {arena}}
     {}
 
-    const std::vector<std::unique_ptr<IStmt>>& BlockStmt::getBody() const
+    const ArenaVector<IStmt*>& BlockStmt::getBody() const
     {
         return body;
     }
 
-    void BlockStmt::addStmt(std::unique_ptr<IStmt> stmt)
+    void BlockStmt::addStmt(IStmt* stmt)
     {
-        body.emplace_back(std::move(stmt));
+        body.push_back(stmt);
     }
 
     std::any BlockStmt::accept(StmtVisitor<std::any>& visitor)